@@ -0,0 +1,44 @@
+// Time of the all_pairs precompute (graph::Router) by thread count. One
+// thread runs the plain precompute, more run the blocked Floyd-Warshall over a
+// thread pool. Build from this directory with
+//   g++ -std=c++17 -O2 -pthread -I../transport-catalogue all_pairs_scaling_benchmark.cpp
+//       $(ls ../transport-catalogue/*.cpp | grep -v main.cpp) -o all_pairs_scaling_benchmark
+// and run as all_pairs_scaling_benchmark [vertex_count] [max_thread_count].
+
+#include "router.h"
+#include "synthetic_network.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+    const size_t vertex_count = argc > 1 ? std::stoul(argv[1]) : 2000;
+    const size_t max_thread_count = argc > 2 ? std::stoul(argv[2])
+                                             : std::max(1u, std::thread::hardware_concurrency());
+    const auto graph = bench::BuildRandomGraph<double>(vertex_count, 4, 5);
+    std::cout << vertex_count << " vertices, " << graph.GetEdgeCount() << " edges\n";
+
+    std::vector<size_t> thread_counts;
+    for (size_t thread_count = 1; thread_count < max_thread_count; thread_count *= 2) {
+        thread_counts.push_back(thread_count);
+    }
+    thread_counts.push_back(max_thread_count);
+
+    double single_thread_seconds = 0.0;
+    for (const size_t thread_count : thread_counts) {
+        thread_pool::ThreadPool pool(thread_count);
+        const double seconds = bench::MeasureSeconds([&] {
+            graph::Router<double> router(graph, pool);
+        });
+        if (thread_count == 1) {
+            single_thread_seconds = seconds;
+        }
+        std::cout << std::setw(3) << thread_count << " threads: " << std::fixed << std::setprecision(3)
+                  << seconds << " s, x" << std::setprecision(2) << single_thread_seconds / seconds << "\n";
+    }
+}
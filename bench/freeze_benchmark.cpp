@@ -0,0 +1,84 @@
+// Bus and Stop query throughput of the catalogue before and after
+// TransportCatalogue::Freeze. Build from this directory with
+//   g++ -std=c++17 -O2 -pthread -I../transport-catalogue freeze_benchmark.cpp
+//       $(ls ../transport-catalogue/*.cpp | grep -v main.cpp) -o freeze_benchmark
+// and run as freeze_benchmark [stop_count] [bus_count] [query_count].
+
+#include "synthetic_network.h"
+#include "transport_catalogue.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct QueryResults {
+    std::vector<double> bus_values;
+    size_t stop_bus_count = 0;
+
+    bool operator==(const QueryResults& other) const {
+        return bus_values == other.bus_values && stop_bus_count == other.stop_bus_count;
+    }
+};
+
+// Answers every query the way the Bus and Stop requests do and prints the
+// rate of each kind.
+QueryResults RunQueries(const transport_catalogue::TransportCatalogue& catalogue
+                        , const std::vector<std::string>& bus_names
+                        , const std::vector<std::string>& stop_names
+                        , const char* label) {
+    QueryResults results;
+    results.bus_values.reserve(bus_names.size() * 4);
+    const double bus_seconds = bench::MeasureSeconds([&] {
+        for (const std::string& bus_name : bus_names) {
+            const auto info = catalogue.GetBusInfo(bus_name);
+            results.bus_values.push_back(info.route_length);
+            results.bus_values.push_back(info.curvature);
+            results.bus_values.push_back(info.stops_count);
+            results.bus_values.push_back(info.unique_stops);
+        }
+    });
+    const double stop_seconds = bench::MeasureSeconds([&] {
+        for (const std::string& stop_name : stop_names) {
+            results.stop_bus_count += catalogue.GetStopInfo(stop_name).size();
+        }
+    });
+    std::cout << std::left << std::setw(9) << label << std::right << std::fixed << std::setprecision(2)
+              << " Bus " << static_cast<double>(bus_names.size()) / bus_seconds / 1e6 << " M/s"
+              << ", Stop " << static_cast<double>(stop_names.size()) / stop_seconds / 1e6 << " M/s\n";
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t stop_count = argc > 1 ? std::stoul(argv[1]) : 50000;
+    const size_t bus_count = argc > 2 ? std::stoul(argv[2]) : 5000;
+    const size_t query_count = argc > 3 ? std::stoul(argv[3]) : 500000;
+    transport_catalogue::TransportCatalogue catalogue;
+    bench::FillCatalogue(catalogue, stop_count, bus_count, 5);
+
+    std::mt19937 random(7);
+    std::vector<std::string> bus_names(query_count);
+    std::vector<std::string> stop_names(query_count);
+    for (size_t i = 0; i < query_count; ++i) {
+        bus_names[i] = bench::GetBusName(random() % bus_count);
+        stop_names[i] = bench::GetStopName(random() % stop_count);
+    }
+    std::cout << stop_count << " stops, " << bus_count << " buses, " << query_count << " queries of each kind\n";
+
+    const QueryResults unfrozen_results = RunQueries(catalogue, bus_names, stop_names, "unfrozen");
+    const double freeze_seconds = bench::MeasureSeconds([&] {
+        catalogue.Freeze();
+    });
+    std::cout << "Freeze took " << std::setprecision(3) << freeze_seconds << " s\n";
+    const QueryResults frozen_results = RunQueries(catalogue, bus_names, stop_names, "frozen");
+    if (!(frozen_results == unfrozen_results)) {
+        std::cerr << "frozen catalogue answers differently" << std::endl;
+        return 1;
+    }
+}
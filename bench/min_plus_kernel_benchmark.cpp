@@ -0,0 +1,159 @@
+// Min-plus row kernels of the all_pairs precompute against the scalar one.
+// Every kernel the CPU supports runs the same Floyd-Warshall steps over rows
+// of a random graph's route table and must leave them identical. Build from
+// this directory with
+//   g++ -std=c++17 -O2 -pthread -I../transport-catalogue min_plus_kernel_benchmark.cpp
+//       $(ls ../transport-catalogue/*.cpp | grep -v main.cpp) -o min_plus_kernel_benchmark
+// and run as min_plus_kernel_benchmark [vertex_count...], 1000 2000 5000 10000 by default.
+
+#include "min_plus_kernel.h"
+#include "synthetic_network.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using graph::detail::MinPlusKernel;
+using graph::detail::PackedEdgeId;
+
+// Rows of the table kept in memory; the first PIVOT_COUNT of them are the
+// vertices routes are relaxed through.
+constexpr size_t ROW_COUNT = 512;
+constexpr size_t PIVOT_COUNT = 64;
+
+const char* GetKernelName(MinPlusKernel kernel) {
+    switch (kernel) {
+    case MinPlusKernel::AVX2:
+        return "avx2";
+    case MinPlusKernel::SSE4:
+        return "sse4";
+    default:
+        return "scalar";
+    }
+}
+
+template <typename Weight>
+struct RouteRows {
+    std::vector<Weight> weights;
+    std::vector<PackedEdgeId> prev_edges;
+
+    bool operator==(const RouteRows& other) const {
+        return weights == other.weights && prev_edges == other.prev_edges;
+    }
+};
+
+// The direct edges of the first ROW_COUNT vertices plus a route from each of
+// them to every pivot, as later in the precompute, so that every row is
+// relaxed through every pivot.
+template <typename Weight>
+RouteRows<Weight> MakeRouteRows(const graph::DirectedWeightedGraph<Weight>& graph) {
+    const size_t vertex_count = graph.GetVertexCount();
+    const Weight no_route = std::numeric_limits<Weight>::has_infinity ? std::numeric_limits<Weight>::infinity()
+                                                                      : std::numeric_limits<Weight>::max();
+    RouteRows<Weight> rows{std::vector<Weight>(ROW_COUNT * vertex_count, no_route)
+                           , std::vector<PackedEdgeId>(ROW_COUNT * vertex_count, graph::detail::NO_EDGE)};
+    for (graph::VertexId vertex = 0; vertex < ROW_COUNT; ++vertex) {
+        rows.weights[vertex * vertex_count + vertex] = Weight{};
+        for (const graph::EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
+            const auto& edge = graph.GetEdge(edge_id);
+            const size_t cell = vertex * vertex_count + edge.to;
+            if (edge.weight < rows.weights[cell]) {
+                rows.weights[cell] = edge.weight;
+                rows.prev_edges[cell] = static_cast<PackedEdgeId>(edge_id);
+            }
+        }
+    }
+    std::mt19937 random(7);
+    for (size_t row = 0; row < ROW_COUNT; ++row) {
+        for (size_t pivot = 0; pivot < PIVOT_COUNT; ++pivot) {
+            const size_t cell = row * vertex_count + pivot;
+            if (row != pivot && rows.weights[cell] == no_route) {
+                rows.weights[cell] = static_cast<Weight>(100 + random() % 1000);
+                rows.prev_edges[cell] = static_cast<PackedEdgeId>(random() % graph.GetEdgeCount());
+            }
+        }
+    }
+    return rows;
+}
+
+// Relaxes every row through each pivot row in turn, as the precompute does.
+template <typename Weight>
+void RelaxThroughPivots(MinPlusKernel kernel, RouteRows<Weight>& rows, size_t vertex_count) {
+    for (size_t pivot = 0; pivot < PIVOT_COUNT; ++pivot) {
+        const Weight* pivot_weights = rows.weights.data() + pivot * vertex_count;
+        const PackedEdgeId* pivot_prev_edges = rows.prev_edges.data() + pivot * vertex_count;
+        for (size_t row = 0; row < ROW_COUNT; ++row) {
+            const size_t cell = row * vertex_count + pivot;
+            if (row == pivot) {
+                continue;
+            }
+            graph::detail::RelaxRowMinPlus(kernel, rows.weights[cell], rows.prev_edges[cell]
+                                           , pivot_weights, pivot_prev_edges
+                                           , rows.weights.data() + row * vertex_count
+                                           , rows.prev_edges.data() + row * vertex_count
+                                           , vertex_count);
+        }
+    }
+}
+
+template <typename Weight>
+void RunBenchmark(const char* weight_name, size_t vertex_count) {
+    const auto graph = bench::BuildRandomGraph<Weight>(vertex_count, 4, 5);
+    const RouteRows<Weight> initial_rows = MakeRouteRows(graph);
+    const double cell_count = static_cast<double>(PIVOT_COUNT * (ROW_COUNT - 1) * vertex_count);
+
+    std::cout << "  " << std::left << std::setw(7) << weight_name << std::right;
+    std::optional<RouteRows<Weight>> scalar_rows;
+    double scalar_seconds = 0.0;
+    for (const MinPlusKernel kernel : {MinPlusKernel::SCALAR, MinPlusKernel::SSE4, MinPlusKernel::AVX2}) {
+        if (kernel > graph::detail::GetMinPlusKernel()) {
+            break;
+        }
+        RouteRows<Weight> rows = initial_rows;
+        const double seconds = bench::MeasureSeconds([&] {
+            RelaxThroughPivots(kernel, rows, vertex_count);
+        });
+        if (!scalar_rows) {
+            scalar_rows = std::move(rows);
+            scalar_seconds = seconds;
+        } else if (!(rows == *scalar_rows)) {
+            std::cerr << GetKernelName(kernel) << " differs from scalar for " << weight_name << std::endl;
+            std::exit(1);
+        }
+        std::cout << "  " << GetKernelName(kernel) << " " << std::fixed << std::setprecision(3)
+                  << seconds * 1e9 / cell_count << " ns/cell x" << std::setprecision(2)
+                  << scalar_seconds / seconds;
+    }
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> vertex_counts;
+    for (int i = 1; i < argc; ++i) {
+        vertex_counts.push_back(std::stoul(argv[i]));
+    }
+    if (vertex_counts.empty()) {
+        vertex_counts = {1000, 2000, 5000, 10000};
+    }
+    std::cout << "best kernel: " << GetKernelName(graph::detail::GetMinPlusKernel()) << "\n";
+    for (const size_t vertex_count : vertex_counts) {
+        if (vertex_count < ROW_COUNT) {
+            std::cerr << "vertex_count must be at least " << ROW_COUNT << std::endl;
+            return 1;
+        }
+        std::cout << vertex_count << " vertices:\n";
+        RunBenchmark<double>("double", vertex_count);
+        RunBenchmark<float>("float", vertex_count);
+        RunBenchmark<uint32_t>("fixed", vertex_count);
+    }
+}
@@ -0,0 +1,99 @@
+// Vertices settled and time per query of the search-based router types on
+// long cross-city routes, from the graph::SearchStats that FindRoute fills in.
+// Every router type must find routes of the same total time. Build from this
+// directory with
+//   g++ -std=c++17 -O2 -pthread -I../transport-catalogue route_search_benchmark.cpp
+//       $(ls ../transport-catalogue/*.cpp | grep -v main.cpp) -o route_search_benchmark
+// and run as route_search_benchmark [stop_count] [bus_count] [query_count].
+
+#include "geo.h"
+#include "synthetic_network.h"
+#include "transport_router.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Query = std::pair<std::string_view, std::string_view>;
+
+// Random pairs of stops at least as far apart as three quarters of all pairs.
+std::vector<Query> GetLongQueries(const transport_catalogue::TransportCatalogue& catalogue, size_t query_count) {
+    const auto& stops = catalogue.GetAllStops();
+    std::mt19937 random(7);
+    std::vector<std::pair<double, Query>> candidates;
+    for (size_t i = 0; i < query_count * 4; ++i) {
+        const auto& stop_from = stops[random() % stops.size()];
+        const auto& stop_to = stops[random() % stops.size()];
+        candidates.push_back({geo::ComputeGeoDistance(stop_from.coordinates, stop_to.coordinates)
+                              , {stop_from.name, stop_to.name}});
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first > rhs.first;
+    });
+    std::vector<Query> result;
+    for (size_t i = 0; i < query_count; ++i) {
+        result.push_back(candidates[i].second);
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t stop_count = argc > 1 ? std::stoul(argv[1]) : 2000;
+    const size_t bus_count = argc > 2 ? std::stoul(argv[2]) : 500;
+    const size_t query_count = argc > 3 ? std::stoul(argv[3]) : 200;
+    transport_catalogue::TransportCatalogue catalogue;
+    bench::FillCatalogue(catalogue, stop_count, bus_count, 5);
+    catalogue.Freeze();
+    const std::vector<Query> queries = GetLongQueries(catalogue, query_count);
+    std::cout << stop_count << " stops, " << bus_count << " buses, " << query_count << " long queries\n";
+
+    const std::vector<std::pair<const char*, transport_router::RouterType>> router_types = {
+        {"dijkstra", transport_router::RouterType::DIJKSTRA},
+        {"a_star", transport_router::RouterType::A_STAR},
+        {"contraction_hierarchy", transport_router::RouterType::CONTRACTION_HIERARCHY},
+        {"implicit_rides", transport_router::RouterType::IMPLICIT_RIDES},
+    };
+    std::vector<std::optional<double>> expected_times;
+    for (const auto& [router_name, router_type] : router_types) {
+        transport_router::RoutingSettings settings;
+        settings.bus_wait_time = 6;
+        settings.bus_velocity = 40.0 * 1000.0 / 60.0;
+        settings.router_type = router_type;
+        const transport_router::TransportRouter router(catalogue, settings);
+
+        std::vector<std::optional<double>> times;
+        size_t settled_vertices = 0;
+        const double seconds = bench::MeasureSeconds([&] {
+            for (const auto& [stop_from, stop_to] : queries) {
+                graph::SearchStats stats;
+                const auto route = router.FindRoute(stop_from, stop_to, &stats);
+                settled_vertices += stats.settled_vertices;
+                times.push_back(route ? std::optional<double>(route->GetTotalTime()) : std::nullopt);
+            }
+        });
+        if (expected_times.empty()) {
+            expected_times = times;
+        }
+        for (size_t i = 0; i < queries.size(); ++i) {
+            if (times[i].has_value() != expected_times[i].has_value()
+                || (times[i] && std::abs(*times[i] - *expected_times[i]) > 1e-6)) {
+                std::cerr << router_name << " differs from " << router_types.front().first << " on "
+                          << queries[i].first << " to " << queries[i].second << std::endl;
+                return 1;
+            }
+        }
+        std::cout << std::left << std::setw(22) << router_name << std::right << std::fixed << std::setprecision(1)
+                  << static_cast<double>(settled_vertices) / static_cast<double>(queries.size())
+                  << " settled/query, " << std::setprecision(3)
+                  << seconds * 1e3 / static_cast<double>(queries.size()) << " ms/query\n";
+    }
+}
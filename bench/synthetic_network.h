@@ -0,0 +1,92 @@
+#pragma once
+
+#include "graph.h"
+#include "transport_catalogue.h"
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+inline std::string GetStopName(size_t index) {
+    return "S" + std::to_string(index);
+}
+
+inline std::string GetBusName(size_t index) {
+    return "B" + std::to_string(index);
+}
+
+// Random stops of a new bus route, 2 to 12 of them.
+inline std::vector<std::string> GetRandomRoute(size_t stop_count, std::mt19937& random) {
+    std::vector<std::string> route(2 + random() % 11);
+    for (std::string& stop : route) {
+        stop = GetStopName(random() % stop_count);
+    }
+    return route;
+}
+
+// Adds the bus with road distances set between its consecutive stops.
+inline void AddRandomBus(transport_catalogue::TransportCatalogue& catalogue
+                         , const std::string& bus_name
+                         , size_t stop_count
+                         , std::mt19937& random) {
+    const std::vector<std::string> route = GetRandomRoute(stop_count, random);
+    for (size_t i = 0; i + 1 < route.size(); ++i) {
+        catalogue.SetStop2StopDistance(route[i], route[i + 1], static_cast<int>(100 + random() % 4900));
+    }
+    const bool is_roundtrip = random() % 5 < 2;
+    std::vector<std::string_view> stops(route.begin(), route.end());
+    if (is_roundtrip) {
+        stops.push_back(stops.front());
+        catalogue.SetStop2StopDistance(route.back(), route.front(), static_cast<int>(100 + random() % 4900));
+    }
+    catalogue.AddBus(bus_name, stops, is_roundtrip);
+}
+
+// A random network of stop_count stops named S0, S1, ... spread over about
+// 30 km and bus_count buses named B0, B1, ...
+inline void FillCatalogue(transport_catalogue::TransportCatalogue& catalogue
+                          , size_t stop_count
+                          , size_t bus_count
+                          , uint32_t seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> coordinate(0.0, 0.3);
+    for (size_t i = 0; i < stop_count; ++i) {
+        catalogue.AddStop(GetStopName(i), {55.0 + coordinate(random), 37.0 + coordinate(random)});
+    }
+    for (size_t i = 0; i < bus_count; ++i) {
+        AddRandomBus(catalogue, GetBusName(i), stop_count, random);
+    }
+}
+
+// A frozen random graph with out_degree edges from every vertex to others,
+// weighing 1 to 100.
+template <typename Weight>
+graph::DirectedWeightedGraph<Weight> BuildRandomGraph(size_t vertex_count, size_t out_degree, uint32_t seed) {
+    std::mt19937 random(seed);
+    graph::DirectedWeightedGraph<Weight> result(vertex_count);
+    std::vector<graph::Edge<Weight>> edges;
+    edges.reserve(vertex_count * out_degree);
+    for (graph::VertexId from = 0; from < vertex_count; ++from) {
+        for (size_t i = 0; i < out_degree; ++i) {
+            const graph::VertexId to = (from + 1 + random() % (vertex_count - 1)) % vertex_count;
+            edges.push_back({0, 0, from, to, static_cast<Weight>(1 + random() % 100)});
+        }
+    }
+    result.AddEdges(edges);
+    result.Freeze();
+    return result;
+}
+
+// Seconds action takes to run once.
+template <typename Action>
+double MeasureSeconds(Action action) {
+    const auto start = std::chrono::steady_clock::now();
+    action();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace bench
@@ -0,0 +1,85 @@
+// Time of TransportRouter::Update against a full rebuild of the all_pairs
+// router after each kind of catalogue change. Build from this directory with
+//   g++ -std=c++17 -O2 -pthread -I../transport-catalogue update_benchmark.cpp
+//       $(ls ../transport-catalogue/*.cpp | grep -v main.cpp) -o update_benchmark
+// and run as update_benchmark [stop_count] [bus_count] [thread_count].
+
+#include "synthetic_network.h"
+#include "transport_router.h"
+
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const char* GetWeightTypeName(transport_router::WeightType weight_type) {
+    switch (weight_type) {
+    case transport_router::WeightType::FLOAT:
+        return "float";
+    case transport_router::WeightType::FIXED_POINT:
+        return "fixed_point";
+    default:
+        return "double";
+    }
+}
+
+void RunBenchmark(size_t stop_count
+                  , size_t bus_count
+                  , const transport_router::RoutingSettings& settings) {
+    transport_catalogue::TransportCatalogue catalogue;
+    bench::FillCatalogue(catalogue, stop_count, bus_count, 5);
+    transport_router::TransportRouter router(catalogue, settings);
+
+    std::mt19937 random(7);
+    const auto change_distance = [&](bool shorter) {
+        const auto& bus = catalogue.GetBusById(static_cast<uint32_t>(random() % bus_count));
+        const auto* stop_from = bus.route_stops[0];
+        const auto* stop_to = bus.route_stops[1];
+        const int distance = catalogue.GetRealDistance(stop_from, stop_to);
+        catalogue.SetStop2StopDistance(stop_from->name, stop_to->name, shorter ? distance / 3 + 1 : distance * 3);
+    };
+    const std::vector<std::pair<std::string, std::function<void()>>> changes = {
+        {"shorter road", [&] { change_distance(true); }},
+        {"longer road", [&] { change_distance(false); }},
+        {"bus replaced", [&] { bench::AddRandomBus(catalogue, bench::GetBusName(0), stop_count, random); }},
+        {"bus removed", [&] { catalogue.RemoveBus(bench::GetBusName(1)); }},
+        {"bus added", [&] { bench::AddRandomBus(catalogue, "NEW", stop_count, random); }},
+    };
+
+    std::cout << GetWeightTypeName(settings.weight_type) << ":\n";
+    for (const auto& [change_name, change] : changes) {
+        change();
+        const double update_seconds = bench::MeasureSeconds([&] {
+            router.Update(catalogue);
+        });
+        const double rebuild_seconds = bench::MeasureSeconds([&] {
+            transport_router::TransportRouter fresh(catalogue, settings);
+        });
+        std::cout << "  " << std::left << std::setw(14) << change_name
+                  << " update " << std::fixed << std::setprecision(3) << update_seconds
+                  << " s, rebuild " << rebuild_seconds << " s\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t stop_count = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const size_t bus_count = argc > 2 ? std::stoul(argv[2]) : 250;
+    transport_router::RoutingSettings settings;
+    settings.bus_wait_time = 6;
+    settings.bus_velocity = 40.0 * 1000.0 / 60.0;
+    settings.thread_count = argc > 3 ? std::stoul(argv[3]) : 1;
+    std::cout << stop_count << " stops, " << bus_count << " buses, "
+              << settings.thread_count << " threads\n";
+    for (const auto weight_type : {transport_router::WeightType::DOUBLE
+                                   , transport_router::WeightType::FLOAT
+                                   , transport_router::WeightType::FIXED_POINT}) {
+        settings.weight_type = weight_type;
+        RunBenchmark(stop_count, bus_count, settings);
+    }
+}
@@ -0,0 +1,100 @@
+// Checks for TransportRouter::FindAlternativeRoutes. Build from this directory with
+//   g++ -std=c++17 -O2 -pthread -I../transport-catalogue alternative_routes_test.cpp
+//       $(ls ../transport-catalogue/*.cpp | grep -v main.cpp) -o alternative_routes_test
+
+#include "transport_catalogue.h"
+#include "transport_router.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void Check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// Bus A stops at S1 to S7, bus B goes from S1 to S7 directly and takes longer.
+// Getting off A and boarding it again is no alternative; B is.
+void TestNoReboardingTheSameBus() {
+    transport_catalogue::TransportCatalogue catalogue;
+    const std::vector<std::string> stops = {"S1", "S2", "S3", "S4", "S5", "S6", "S7"};
+    for (size_t i = 0; i < stops.size(); ++i) {
+        catalogue.AddStop(stops[i], {55.6 + 0.01 * static_cast<double>(i), 37.6});
+    }
+    for (size_t i = 0; i + 1 < stops.size(); ++i) {
+        catalogue.SetStop2StopDistance(stops[i], stops[i + 1], 1000);
+    }
+    catalogue.SetStop2StopDistance("S1", "S7", 9000);
+    catalogue.AddBus("A", {stops.begin(), stops.end()}, true);
+    catalogue.AddBus("B", {"S1", "S7"}, true);
+    catalogue.Freeze();
+
+    transport_router::RoutingSettings settings;
+    settings.bus_wait_time = 2;
+    settings.bus_velocity = 500;
+    settings.router_type = transport_router::RouterType::DIJKSTRA;
+    const transport_router::TransportRouter router(catalogue, settings);
+
+    const auto routes = router.FindAlternativeRoutes("S1", "S7", 3);
+    Check(routes.size() == 2, "two routes on distinct buses");
+    const auto get_bus_names = [&catalogue](const std::vector<graph::Edge<double>>& route) {
+        std::vector<std::string_view> names;
+        for (const auto& edge : route) {
+            if (edge.span_count > 0) {
+                names.push_back(catalogue.GetBusById(edge.name_id).name);
+            }
+        }
+        return names;
+    };
+    Check(get_bus_names(routes[0]) == std::vector<std::string_view>{"A"}, "the fastest route rides A");
+    Check(get_bus_names(routes[1]) == std::vector<std::string_view>{"B"}, "the alternative rides B");
+}
+
+// Bus A runs from X through M0 to M29 and bus B from M0 through M29 to Y.
+// Every set of stops to change between them at gives a loopless route, and
+// the ones with the same number of changes share a bus sequence. The search
+// must give up on them instead of enumerating millions of routes.
+void TestExplorationIsBounded() {
+    transport_catalogue::TransportCatalogue catalogue;
+    std::vector<std::string> stops = {"X"};
+    for (size_t i = 0; i < 30; ++i) {
+        stops.push_back("M" + std::to_string(i));
+    }
+    stops.push_back("Y");
+    for (size_t i = 0; i < stops.size(); ++i) {
+        catalogue.AddStop(stops[i], {55.6 + 0.01 * static_cast<double>(i), 37.6});
+    }
+    for (size_t i = 0; i + 1 < stops.size(); ++i) {
+        catalogue.SetStop2StopDistance(stops[i], stops[i + 1], 1000);
+    }
+    catalogue.AddBus("A", {stops.begin(), stops.end() - 1}, true);
+    catalogue.AddBus("B", {stops.begin() + 1, stops.end()}, true);
+    catalogue.Freeze();
+
+    transport_router::RoutingSettings settings;
+    settings.bus_wait_time = 2;
+    settings.bus_velocity = 500;
+    settings.router_type = transport_router::RouterType::DIJKSTRA;
+    const transport_router::TransportRouter router(catalogue, settings);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto routes = router.FindAlternativeRoutes("X", "Y", 6);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    Check(!routes.empty() && routes.size() < 6, "fewer routes than asked for");
+    Check(elapsed < std::chrono::seconds(5), "the search gives up in time");
+}
+
+} // namespace
+
+int main() {
+    TestNoReboardingTheSameBus();
+    TestExplorationIsBounded();
+    std::cout << "alternative_routes_test: OK" << std::endl;
+}
@@ -0,0 +1,99 @@
+// Checks that the a_star router finds routes as fast as dijkstra does. Build
+// from this directory with
+//   g++ -std=c++17 -O2 -pthread -I../transport-catalogue astar_router_test.cpp
+//       $(ls ../transport-catalogue/*.cpp | grep -v main.cpp) -o astar_router_test
+
+#include "geo.h"
+#include "transport_catalogue.h"
+#include "transport_router.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// Clusters of stops that share their coordinates or lie from a tenth of a
+// millimetre to a metre apart, where the geographic lower bounds of A* are at
+// their least accurate. For some of these the cosine of the angle between
+// stops rounds past 1. Roads between clusters are as long as the straight
+// line rounded up, so the bounds are as tight as they can be, and roads
+// within a cluster are a metre long.
+void TestCloseStops() {
+    transport_catalogue::TransportCatalogue catalogue;
+    std::mt19937 random(11);
+    std::vector<std::string> stops;
+    std::vector<geo::Coordinates> coordinates;
+    std::vector<size_t> clusters;
+    const double offsets[] = {0.0, 0.0, 1e-9, 1e-8, 1e-7, 1e-5};
+    const int cluster_steps[] = {34, 76, 242, 288, 352, 400, 638};
+    for (size_t cluster = 0; cluster < std::size(cluster_steps); ++cluster) {
+        const double lat = 55.6 + 0.0001 * cluster_steps[cluster];
+        const double lng = 37.6 + 0.00007 * cluster_steps[cluster];
+        for (const double offset : offsets) {
+            stops.push_back("C" + std::to_string(cluster) + "S" + std::to_string(stops.size()));
+            coordinates.push_back({lat + offset, lng - offset});
+            clusters.push_back(cluster);
+            catalogue.AddStop(stops.back(), coordinates.back());
+        }
+    }
+    for (size_t from = 0; from < stops.size(); ++from) {
+        for (size_t to = 0; to < stops.size(); ++to) {
+            if (clusters[from] != clusters[to]) {
+                const double distance = geo::ComputeHaversineDistance(coordinates[from], coordinates[to]);
+                catalogue.SetStop2StopDistance(stops[from], stops[to], static_cast<int>(std::ceil(distance)));
+            } else if (from != to) {
+                catalogue.SetStop2StopDistance(stops[from], stops[to], 1);
+            }
+        }
+    }
+    std::uniform_int_distribution<size_t> stop_index(0, stops.size() - 1);
+    for (size_t bus = 0; bus < 16; ++bus) {
+        std::vector<std::string_view> route;
+        for (size_t i = 0; i < 8; ++i) {
+            route.push_back(stops[stop_index(random)]);
+        }
+        catalogue.AddBus("B" + std::to_string(bus), route, false);
+    }
+    catalogue.Freeze();
+
+    transport_router::RoutingSettings settings;
+    settings.bus_wait_time = 1;
+    settings.bus_velocity = 500;
+    settings.router_type = transport_router::RouterType::DIJKSTRA;
+    const transport_router::TransportRouter dijkstra(catalogue, settings);
+    settings.router_type = transport_router::RouterType::A_STAR;
+    const transport_router::TransportRouter a_star(catalogue, settings);
+
+    for (const std::string& stop_from : stops) {
+        for (const std::string& stop_to : stops) {
+            const auto expected = dijkstra.FindRoute(stop_from, stop_to);
+            const auto route = a_star.FindRoute(stop_from, stop_to);
+            const std::string query = stop_from + " to " + stop_to;
+            Check(route.has_value() == expected.has_value(), "route found for " + query);
+            if (expected) {
+                Check(std::abs(route->GetTotalTime() - expected->GetTotalTime()) < 1e-9
+                      , "a_star time " + std::to_string(route->GetTotalTime()) + " and dijkstra time "
+                        + std::to_string(expected->GetTotalTime()) + " for " + query);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    TestCloseStops();
+    std::cout << "astar_router_test: OK" << std::endl;
+}
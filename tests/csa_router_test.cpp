@@ -0,0 +1,61 @@
+// Regression checks for ConnectionScanRouter. Build from this directory with
+//   g++ -std=c++17 -O2 -pthread -I../transport-catalogue csa_router_test.cpp
+//       $(ls ../transport-catalogue/*.cpp | grep -v main.cpp) -o csa_router_test
+
+#include "transport_catalogue.h"
+#include "transport_router.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+void Check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// Two zero length rides at the same minute where the one that comes second
+// feeds the first: bus C takes S13 to S55 and bus D, added before it, S55 to S63.
+// The fastest route from S45 changes to C and then to D at 500.
+void TestChainedZeroLengthConnections() {
+    transport_catalogue::TransportCatalogue catalogue;
+    for (const char* stop : {"S45", "S13", "S55", "S63"}) {
+        catalogue.AddStop(stop, {55.6, 37.6});
+    }
+    catalogue.SetStop2StopDistance("S45", "S13", 12000);
+    catalogue.SetStop2StopDistance("S45", "S63", 13800);
+    catalogue.SetStop2StopDistance("S13", "S55", 0);
+    catalogue.SetStop2StopDistance("S55", "S13", 0);
+    catalogue.SetStop2StopDistance("S55", "S63", 0);
+    catalogue.SetStop2StopDistance("S63", "S55", 0);
+    catalogue.AddBus("A", {"S45", "S13"}, false, {480});
+    catalogue.AddBus("D", {"S55", "S63", "S55"}, true, {500});
+    catalogue.AddBus("C", {"S13", "S55", "S13"}, true, {500});
+    catalogue.AddBus("E", {"S45", "S63"}, false, {480});
+    catalogue.Freeze();
+
+    transport_router::RoutingSettings settings;
+    settings.bus_wait_time = 1;
+    settings.bus_velocity = 600;
+    settings.router_type = transport_router::RouterType::DIJKSTRA;
+    const transport_router::TransportRouter router(catalogue, settings);
+
+    const auto route = router.FindRouteAt("S45", "S63", 480);
+    Check(route.has_value(), "S45 to S63 at 480 has a route");
+    double total_time = 0.0;
+    for (const auto& edge : *route) {
+        total_time += edge.weight;
+    }
+    Check(std::abs(total_time - 20.0) < 1e-9, "S45 to S63 at 480 arrives at 500");
+}
+
+} // namespace
+
+int main() {
+    TestChainedZeroLengthConnections();
+    std::cout << "csa_router_test: OK" << std::endl;
+}
@@ -0,0 +1,47 @@
+// Checks for TransportCatalogue. Build from this directory with
+//   g++ -std=c++17 -O2 -pthread -I../transport-catalogue transport_catalogue_test.cpp
+//       $(ls ../transport-catalogue/*.cpp | grep -v main.cpp) -o transport_catalogue_test
+
+#include "transport_catalogue.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+void Check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// A stop given twice is one stop with the last coordinates, and Freeze builds
+// its name hash over distinct names.
+void TestDuplicateStopBeforeFreeze() {
+    transport_catalogue::TransportCatalogue catalogue;
+    catalogue.AddStop("S1", {55.60, 37.60});
+    catalogue.AddStop("S2", {55.61, 37.60});
+    catalogue.SetStop2StopDistance("S1", "S2", 1500);
+    catalogue.AddStop("S1", {55.62, 37.61});
+    catalogue.AddBus("A", {"S1", "S2"}, false);
+    catalogue.Freeze();
+
+    Check(catalogue.GetAllStops().size() == 2, "the repeated stop is not added again");
+    const auto* stop = catalogue.GetStop("S1");
+    Check(stop != nullptr, "the repeated stop is found after Freeze");
+    Check(stop->coordinates.lat == 55.62 && stop->coordinates.lng == 37.61, "the last coordinates win");
+    Check(catalogue.GetRealDistance(stop, catalogue.GetStop("S2")) == 1500
+          , "distances set before the repeat still apply");
+    Check(catalogue.GetStopInfo("S1") == std::vector<std::string_view>{"A"}, "the bus goes through the stop");
+    Check(catalogue.GetBusInfo("A").unique_stops == 2, "the bus has two distinct stops");
+}
+
+} // namespace
+
+int main() {
+    TestDuplicateStopBeforeFreeze();
+    std::cout << "transport_catalogue_test: OK" << std::endl;
+}
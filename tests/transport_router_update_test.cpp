@@ -0,0 +1,149 @@
+// Checks that TransportRouter::Update gives the same routes as a router built
+// from scratch. Build from this directory with
+//   g++ -std=c++17 -O2 -pthread -I../transport-catalogue transport_router_update_test.cpp
+//       $(ls ../transport-catalogue/*.cpp | grep -v main.cpp) -o transport_router_update_test
+
+#include "transport_catalogue.h"
+#include "transport_router.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t STOP_COUNT = 60;
+constexpr size_t BUS_COUNT = 12;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+std::string GetStopName(size_t index) {
+    return "S" + std::to_string(index);
+}
+
+std::vector<std::string_view> GetRandomStops(const std::vector<std::string>& stop_names, std::mt19937& random) {
+    std::vector<std::string_view> stops;
+    const size_t stop_count = 3 + random() % 8;
+    for (size_t i = 0; i < stop_count; ++i) {
+        stops.push_back(stop_names[random() % stop_names.size()]);
+    }
+    return stops;
+}
+
+void FillCatalogue(transport_catalogue::TransportCatalogue& catalogue
+                   , const std::vector<std::string>& stop_names
+                   , std::mt19937& random) {
+    std::uniform_real_distribution<double> coordinate(0.0, 0.05);
+    for (const std::string& stop_name : stop_names) {
+        catalogue.AddStop(stop_name, {55.6 + coordinate(random), 37.6 + coordinate(random)});
+    }
+    for (size_t i = 0; i < stop_names.size() * 3; ++i) {
+        catalogue.SetStop2StopDistance(stop_names[random() % stop_names.size()]
+                                       , stop_names[random() % stop_names.size()]
+                                       , static_cast<int>(300 + random() % 3000));
+    }
+    for (size_t i = 0; i < BUS_COUNT; ++i) {
+        catalogue.AddBus("B" + std::to_string(i), GetRandomStops(stop_names, random), random() % 3 == 0);
+    }
+}
+
+// The all_pairs tables of FLOAT and FIXED_POINT round every edge, so routes
+// tied there may differ by the rounding of their edges.
+double GetTolerance(transport_router::WeightType weight_type, size_t edge_count) {
+    switch (weight_type) {
+    case transport_router::WeightType::FLOAT:
+        return 1e-4 * static_cast<double>(edge_count);
+    case transport_router::WeightType::FIXED_POINT:
+        return 1e-3 * static_cast<double>(edge_count);
+    default:
+        return 1e-9;
+    }
+}
+
+void CheckSameRoutes(const transport_router::TransportRouter& updated
+                     , const transport_catalogue::TransportCatalogue& catalogue
+                     , const transport_router::RoutingSettings& settings
+                     , const std::vector<std::string>& stop_names
+                     , const std::string& step) {
+    const transport_router::TransportRouter fresh(catalogue, settings);
+    for (const std::string& stop_from : stop_names) {
+        for (const std::string& stop_to : stop_names) {
+            const auto updated_route = updated.FindRoute(stop_from, stop_to);
+            const auto fresh_route = fresh.FindRoute(stop_from, stop_to);
+            const std::string pair = step + ": " + stop_from + " to " + stop_to;
+            Check(updated_route.has_value() == fresh_route.has_value(), pair + " is found by both");
+            if (!fresh_route) {
+                continue;
+            }
+            double updated_time = 0.0;
+            size_t edge_count = 0;
+            for (const auto& edge : *updated_route) {
+                updated_time += edge.weight;
+                ++edge_count;
+            }
+            double fresh_time = 0.0;
+            for (const auto& edge : *fresh_route) {
+                fresh_time += edge.weight;
+            }
+            Check(std::abs(updated_time - fresh_time) <= GetTolerance(settings.weight_type, edge_count)
+                  , pair + " takes the same time");
+        }
+    }
+}
+
+void TestUpdateMatchesRebuild(transport_router::WeightType weight_type) {
+    std::mt19937 random(5);
+    std::vector<std::string> stop_names;
+    for (size_t i = 0; i < STOP_COUNT; ++i) {
+        stop_names.push_back(GetStopName(i));
+    }
+    transport_catalogue::TransportCatalogue catalogue;
+    FillCatalogue(catalogue, stop_names, random);
+
+    transport_router::RoutingSettings settings;
+    settings.bus_wait_time = 3;
+    settings.bus_velocity = 500;
+    settings.weight_type = weight_type;
+    transport_router::TransportRouter router(catalogue, settings);
+
+    for (size_t step = 0; step < 4; ++step) {
+        const auto& bus = catalogue.GetBusById(static_cast<uint32_t>(random() % BUS_COUNT));
+        const size_t position = random() % (bus.route_stops.size() - 1);
+        const auto* stop_from = bus.route_stops[position];
+        const auto* stop_to = bus.route_stops[position + 1];
+        const int distance = catalogue.GetRealDistance(stop_from, stop_to);
+        // Shorter roads need the table relaxed, longer ones need it rebuilt around them.
+        catalogue.SetStop2StopDistance(stop_from->name, stop_to->name, step % 2 == 0 ? distance / 3 + 1 : distance * 3);
+        router.Update(catalogue);
+        CheckSameRoutes(router, catalogue, settings, stop_names, "distance change " + std::to_string(step));
+    }
+
+    catalogue.AddBus("B0", GetRandomStops(stop_names, random), false);
+    router.Update(catalogue);
+    CheckSameRoutes(router, catalogue, settings, stop_names, "bus replaced");
+
+    catalogue.RemoveBus("B1");
+    router.Update(catalogue);
+    CheckSameRoutes(router, catalogue, settings, stop_names, "bus removed");
+
+    catalogue.AddBus("NEW", GetRandomStops(stop_names, random), true);
+    router.Update(catalogue);
+    CheckSameRoutes(router, catalogue, settings, stop_names, "bus added");
+}
+
+} // namespace
+
+int main() {
+    TestUpdateMatchesRebuild(transport_router::WeightType::DOUBLE);
+    TestUpdateMatchesRebuild(transport_router::WeightType::FLOAT);
+    TestUpdateMatchesRebuild(transport_router::WeightType::FIXED_POINT);
+    std::cout << "transport_router_update_test: OK" << std::endl;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "graph.h"
+#include "router.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// Bidirectional A* search. lower_bound(from, to) must never exceed the weight of
+// the shortest route between the vertices and must satisfy the triangle inequality.
+// Both searches run on weights reduced by the average of the forward and backward
+// potentials, which keeps them non-negative and lets the usual bidirectional
+// Dijkstra stopping rule stay exact.
+template <typename Weight>
+class BidirectionalAStarRouter {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+public:
+    using RouteInfo = graph::RouteInfo<Weight>;
+    using LowerBound = std::function<Weight(VertexId from, VertexId to)>;
+
+    BidirectionalAStarRouter(const Graph& graph, LowerBound lower_bound);
+
+    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to,
+                                        SearchStats* stats = nullptr) const;
+
+private:
+    using QueueItem = std::pair<Weight, VertexId>;
+    using Queue = std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>>;
+
+    struct SearchSide {
+        explicit SearchSide(size_t vertex_count)
+            : distances(vertex_count)
+            , edges(vertex_count) {
+        }
+
+        std::vector<std::optional<Weight>> distances;
+        // The edge the side reached each vertex by.
+        std::vector<std::optional<EdgeId>> edges;
+        Queue queue;
+    };
+
+    ranges::Range<const EdgeId*> GetIncomingEdges(VertexId vertex) const;
+
+    static constexpr Weight ZERO_WEIGHT{};
+    const Graph& graph_;
+    LowerBound lower_bound_;
+    // Incoming edges in compressed sparse row form, see GetIncomingEdges.
+    std::vector<size_t> incoming_offsets_;
+    std::vector<EdgeId> incoming_edges_;
+};
+
+template <typename Weight>
+BidirectionalAStarRouter<Weight>::BidirectionalAStarRouter(const Graph& graph,
+                                                           LowerBound lower_bound)
+    : graph_(graph)
+    , lower_bound_(std::move(lower_bound))
+    , incoming_offsets_(graph.GetVertexCount() + 1, 0)
+    , incoming_edges_(graph.GetEdgeCount())
+{
+    CheckNonNegativeWeights(graph);
+    for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+        ++incoming_offsets_[graph.GetEdge(edge_id).to + 1];
+    }
+    std::partial_sum(incoming_offsets_.begin(), incoming_offsets_.end(), incoming_offsets_.begin());
+    std::vector<size_t> positions(incoming_offsets_.begin(), incoming_offsets_.end() - 1);
+    for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+        incoming_edges_[positions[graph.GetEdge(edge_id).to]++] = edge_id;
+    }
+}
+
+template <typename Weight>
+ranges::Range<const EdgeId*> BidirectionalAStarRouter<Weight>::GetIncomingEdges(VertexId vertex) const {
+    return {incoming_edges_.data() + incoming_offsets_[vertex]
+            , incoming_edges_.data() + incoming_offsets_[vertex + 1]};
+}
+
+template <typename Weight>
+std::optional<typename BidirectionalAStarRouter<Weight>::RouteInfo>
+BidirectionalAStarRouter<Weight>::BuildRoute(VertexId from, VertexId to,
+                                             SearchStats* stats) const {
+    const size_t vertex_count = graph_.GetVertexCount();
+    if (from >= vertex_count || to >= vertex_count) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+
+    std::vector<std::optional<Weight>> potentials(vertex_count);
+    const auto get_potential = [&](VertexId vertex) {
+        auto& potential = potentials[vertex];
+        if (!potential) {
+            potential = (lower_bound_(vertex, to) - lower_bound_(from, vertex)) / Weight{2};
+        }
+        return *potential;
+    };
+    // Consistent bounds keep reduced weights non-negative up to the rounding of
+    // the potentials. A bound that breaks the triangle inequality is a bug in
+    // it, which clamping the weight would only hide.
+    const auto get_reduced_weight = [&](const Edge<Weight>& edge) {
+        const Weight potential_from = get_potential(edge.from);
+        const Weight potential_to = get_potential(edge.to);
+        const Weight reduced_weight = edge.weight - potential_from + potential_to;
+        assert(reduced_weight >= -(std::abs(potential_from) + std::abs(potential_to) + edge.weight)
+                                  * std::numeric_limits<Weight>::epsilon() * Weight{8});
+        return reduced_weight;
+    };
+
+    SearchSide forward(vertex_count);
+    SearchSide backward(vertex_count);
+    forward.distances[from] = ZERO_WEIGHT;
+    forward.queue.push({ZERO_WEIGHT, from});
+    backward.distances[to] = ZERO_WEIGHT;
+    backward.queue.push({ZERO_WEIGHT, to});
+
+    std::optional<Weight> best_weight;
+    VertexId meeting_vertex = from;
+    const auto try_meet = [&](VertexId vertex) {
+        if (forward.distances[vertex] && backward.distances[vertex]) {
+            const Weight weight = *forward.distances[vertex] + *backward.distances[vertex];
+            if (!best_weight || weight < *best_weight) {
+                best_weight = weight;
+                meeting_vertex = vertex;
+            }
+        }
+    };
+
+    try_meet(from);
+
+    size_t settled_vertices = 0;
+    while (!forward.queue.empty() && !backward.queue.empty()) {
+        if (best_weight
+            && forward.queue.top().first + backward.queue.top().first >= *best_weight) {
+            break;
+        }
+        const bool is_forward = forward.queue.top().first <= backward.queue.top().first;
+        SearchSide& side = is_forward ? forward : backward;
+        const auto [distance, vertex] = side.queue.top();
+        side.queue.pop();
+        if (distance > *side.distances[vertex]) {
+            continue;
+        }
+        ++settled_vertices;
+
+        const auto edge_ids = is_forward ? graph_.GetIncidentEdges(vertex)
+                                         : GetIncomingEdges(vertex);
+        for (const EdgeId edge_id : edge_ids) {
+            const auto& edge = graph_.GetEdge(edge_id);
+            const VertexId next_vertex = is_forward ? edge.to : edge.from;
+            const Weight candidate = distance + get_reduced_weight(edge);
+            auto& next_distance = side.distances[next_vertex];
+            if (!next_distance || candidate < *next_distance) {
+                next_distance = candidate;
+                side.edges[next_vertex] = edge_id;
+                side.queue.push({candidate, next_vertex});
+                try_meet(next_vertex);
+            }
+        }
+    }
+    if (stats) {
+        stats->settled_vertices = settled_vertices;
+    }
+    if (!best_weight) {
+        return std::nullopt;
+    }
+
+    std::vector<EdgeId> edges;
+    for (VertexId vertex = meeting_vertex; vertex != from && forward.edges[vertex];) {
+        edges.push_back(*forward.edges[vertex]);
+        vertex = graph_.GetEdge(*forward.edges[vertex]).from;
+    }
+    std::reverse(edges.begin(), edges.end());
+    for (VertexId vertex = meeting_vertex; vertex != to && backward.edges[vertex];) {
+        edges.push_back(*backward.edges[vertex]);
+        vertex = graph_.GetEdge(*backward.edges[vertex]).to;
+    }
+
+    Weight weight = ZERO_WEIGHT;
+    for (const EdgeId edge_id : edges) {
+        weight += graph_.GetEdge(edge_id).weight;
+    }
+    return RouteInfo{weight, std::move(edges)};
+}
+
+}  // namespace graph
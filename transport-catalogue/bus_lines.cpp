@@ -0,0 +1,80 @@
+#include "bus_lines.h"
+
+#include <stdexcept>
+
+namespace transport_router {
+
+std::vector<size_t> BusLine::GetReverseStops() const {
+    return {stops.rbegin(), stops.rend()};
+}
+
+std::vector<int64_t> BusLine::GetReverseDistances() const {
+    std::vector<int64_t> result;
+    result.reserve(backward_distances.size());
+    for (auto distance = backward_distances.rbegin(); distance != backward_distances.rend(); ++distance) {
+        result.push_back(backward_distances.back() - *distance);
+    }
+    return result;
+}
+
+BusLines::BusLines(const transport_catalogue::TransportCatalogue& catalogue
+                   , const std::unordered_map<std::string_view, graph::VertexId>& stop_to_vertex_ids) {
+    std::unordered_map<const transport_catalogue::Stop*, size_t> stop_indexes;
+    stops_.reserve(stop_to_vertex_ids.size());
+    stop_vertices_.reserve(stop_to_vertex_ids.size());
+    for (const auto& [stop_name, vertex_id] : stop_to_vertex_ids) {
+        const transport_catalogue::Stop* stop = catalogue.GetStop(stop_name);
+        stop_indexes[stop] = stops_.size();
+        vertex_to_stop_[vertex_id] = stops_.size();
+        stops_.push_back(stop);
+        stop_vertices_.push_back(vertex_id);
+    }
+
+    for (const transport_catalogue::Bus* bus : catalogue.GetAllBuses()) {
+        BusLine& line = lines_.emplace_back();
+        line.bus = bus;
+        line.stops.reserve(bus->route_stops.size());
+        line.forward_distances.reserve(bus->route_stops.size());
+        line.backward_distances.reserve(bus->route_stops.size());
+        for (size_t position = 0; position < bus->route_stops.size(); ++position) {
+            const auto* stop = bus->route_stops[position];
+            line.stops.push_back(stop_indexes.at(stop));
+            if (position == 0) {
+                line.forward_distances.push_back(0);
+                line.backward_distances.push_back(0);
+            } else {
+                const auto* prev_stop = bus->route_stops[position - 1];
+                line.forward_distances.push_back(line.forward_distances.back()
+                                                 + catalogue.GetRealDistance(prev_stop, stop));
+                line.backward_distances.push_back(line.backward_distances.back()
+                                                  + catalogue.GetRealDistance(stop, prev_stop));
+            }
+        }
+    }
+}
+
+size_t BusLines::GetStopCount() const {
+    return stops_.size();
+}
+
+const transport_catalogue::Stop& BusLines::GetStop(size_t stop) const {
+    return *stops_[stop];
+}
+
+graph::VertexId BusLines::GetStopVertex(size_t stop) const {
+    return stop_vertices_[stop];
+}
+
+size_t BusLines::GetStopIndex(graph::VertexId vertex) const {
+    const auto stop_index = vertex_to_stop_.find(vertex);
+    if (stop_index == vertex_to_stop_.end()) {
+        throw std::out_of_range("Vertex is not a stop");
+    }
+    return stop_index->second;
+}
+
+const std::vector<BusLine>& BusLines::GetLines() const {
+    return lines_;
+}
+
+} // namespace transport_router
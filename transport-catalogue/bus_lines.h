@@ -0,0 +1,51 @@
+#pragma once
+
+#include "graph.h"
+#include "transport_catalogue.h"
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace transport_router {
+
+// A bus route over dense stop indexes with prefix sums of road distances, so
+// the distance between any two of its stops is one subtraction.
+struct BusLine {
+    const transport_catalogue::Bus* bus = nullptr;
+    std::vector<size_t> stops;
+    // Road distance from the first stop to each stop along the route, and the
+    // same sums for travelling each segment in the opposite direction.
+    std::vector<int64_t> forward_distances;
+    std::vector<int64_t> backward_distances;
+
+    // The stops from the last one and the road distance from it to each of
+    // them, for riding a route that is not a roundtrip backwards.
+    std::vector<size_t> GetReverseStops() const;
+    std::vector<int64_t> GetReverseDistances() const;
+};
+
+// The stops of the catalogue numbered densely, with the wait vertex of each,
+// and a BusLine for every bus in order of id. Shared by the routers that scan
+// bus routes instead of graph edges.
+class BusLines {
+public:
+    BusLines(const transport_catalogue::TransportCatalogue& catalogue
+             , const std::unordered_map<std::string_view, graph::VertexId>& stop_to_vertex_ids);
+
+    size_t GetStopCount() const;
+    const transport_catalogue::Stop& GetStop(size_t stop) const;
+    graph::VertexId GetStopVertex(size_t stop) const;
+    // Index of the stop with this wait vertex; throws std::out_of_range for other vertices.
+    size_t GetStopIndex(graph::VertexId vertex) const;
+    const std::vector<BusLine>& GetLines() const;
+
+private:
+    std::vector<const transport_catalogue::Stop*> stops_;
+    std::vector<graph::VertexId> stop_vertices_;
+    std::unordered_map<graph::VertexId, size_t> vertex_to_stop_;
+    std::vector<BusLine> lines_;
+};
+
+} // namespace transport_router
@@ -0,0 +1,405 @@
+#pragma once
+
+#include "graph.h"
+#include "router.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// Contraction Hierarchies. Preprocessing contracts vertices one by one in order of
+// increasing importance and adds shortcut edges that keep every shortest route
+// length intact. Queries run a bidirectional Dijkstra that only climbs the
+// hierarchy and then unpack shortcuts back into the original edges.
+template <typename Weight>
+class ContractionHierarchyRouter {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+public:
+    using RouteInfo = graph::RouteInfo<Weight>;
+
+    explicit ContractionHierarchyRouter(const Graph& graph);
+
+    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to,
+                                        SearchStats* stats = nullptr) const;
+
+    size_t GetShortcutCount() const;
+
+private:
+    using ChEdgeId = size_t;
+    using QueueItem = std::pair<Weight, VertexId>;
+    using Queue = std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>>;
+
+    // Either an original edge or a shortcut replacing the pair of hierarchy
+    // edges from -> contracted vertex -> to.
+    struct ChEdge {
+        VertexId from;
+        VertexId to;
+        Weight weight;
+        std::optional<EdgeId> original_edge;
+        ChEdgeId first_child = 0;
+        ChEdgeId second_child = 0;
+    };
+
+    // Mutable state used only while contracting.
+    struct ContractionState {
+        explicit ContractionState(size_t vertex_count)
+            : outgoing(vertex_count)
+            , incoming(vertex_count)
+            , contracted_neighbors(vertex_count, 0)
+            , levels(vertex_count, 0)
+            , witness_distances(vertex_count) {
+        }
+
+        // Edges between vertices that are not contracted yet, at most one per pair.
+        std::vector<std::vector<ChEdgeId>> outgoing;
+        std::vector<std::vector<ChEdgeId>> incoming;
+        std::vector<int64_t> contracted_neighbors;
+        std::vector<int64_t> levels;
+        std::vector<std::optional<Weight>> witness_distances;
+        std::vector<VertexId> witness_touched;
+    };
+
+    struct SearchSide {
+        explicit SearchSide(size_t vertex_count)
+            : distances(vertex_count)
+            , edges(vertex_count) {
+        }
+
+        std::vector<std::optional<Weight>> distances;
+        std::vector<std::optional<ChEdgeId>> edges;
+        Queue queue;
+    };
+
+    // Witness searches give up after settling this many vertices and keep the shortcut.
+    static constexpr size_t WITNESS_SETTLED_LIMIT = 100;
+    static constexpr Weight ZERO_WEIGHT{};
+
+    void RunWitnessSearch(ContractionState& state, VertexId source, VertexId excluded,
+                          Weight max_weight) const;
+    void AddEdge(ContractionState& state, const ChEdge& ch_edge);
+    size_t ContractVertex(ContractionState& state, VertexId vertex, bool add_shortcuts);
+    void RemoveVertex(ContractionState& state, VertexId vertex);
+    int64_t ComputePriority(ContractionState& state, VertexId vertex);
+    void BuildHierarchy(ContractionState& state);
+    void UnpackEdge(ChEdgeId ch_edge_id, std::vector<EdgeId>& edges) const;
+
+    const Graph& graph_;
+    std::vector<ChEdge> ch_edges_;
+    std::vector<size_t> ranks_;
+    // up_edges_[v] lead from v to higher ranked vertices, down_edges_[v] lead into v
+    // from higher ranked vertices.
+    std::vector<std::vector<ChEdgeId>> up_edges_;
+    std::vector<std::vector<ChEdgeId>> down_edges_;
+    size_t shortcut_count_ = 0;
+};
+
+template <typename Weight>
+ContractionHierarchyRouter<Weight>::ContractionHierarchyRouter(const Graph& graph)
+    : graph_(graph)
+    , ranks_(graph.GetVertexCount())
+    , up_edges_(graph.GetVertexCount())
+    , down_edges_(graph.GetVertexCount())
+{
+    CheckNonNegativeWeights(graph);
+    ContractionState state(graph.GetVertexCount());
+    ch_edges_.reserve(graph.GetEdgeCount());
+    for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+        const auto& edge = graph.GetEdge(edge_id);
+        if (edge.from != edge.to) {
+            AddEdge(state, {edge.from, edge.to, edge.weight, edge_id});
+        }
+    }
+    BuildHierarchy(state);
+}
+
+template <typename Weight>
+size_t ContractionHierarchyRouter<Weight>::GetShortcutCount() const {
+    return shortcut_count_;
+}
+
+template <typename Weight>
+void ContractionHierarchyRouter<Weight>::RunWitnessSearch(ContractionState& state,
+                                                          VertexId source, VertexId excluded,
+                                                          Weight max_weight) const {
+    for (const VertexId vertex : state.witness_touched) {
+        state.witness_distances[vertex].reset();
+    }
+    state.witness_touched.clear();
+
+    Queue queue;
+    state.witness_distances[source] = ZERO_WEIGHT;
+    state.witness_touched.push_back(source);
+    queue.push({ZERO_WEIGHT, source});
+    size_t settled_vertices = 0;
+    while (!queue.empty() && settled_vertices < WITNESS_SETTLED_LIMIT) {
+        const auto [distance, vertex] = queue.top();
+        queue.pop();
+        if (distance > *state.witness_distances[vertex]) {
+            continue;
+        }
+        if (distance > max_weight) {
+            break;
+        }
+        ++settled_vertices;
+        for (const ChEdgeId ch_edge_id : state.outgoing[vertex]) {
+            const ChEdge& ch_edge = ch_edges_[ch_edge_id];
+            if (ch_edge.to == excluded) {
+                continue;
+            }
+            const Weight candidate = distance + ch_edge.weight;
+            auto& next_distance = state.witness_distances[ch_edge.to];
+            if (!next_distance || candidate < *next_distance) {
+                if (!next_distance) {
+                    state.witness_touched.push_back(ch_edge.to);
+                }
+                next_distance = candidate;
+                queue.push({candidate, ch_edge.to});
+            }
+        }
+    }
+}
+
+template <typename Weight>
+void ContractionHierarchyRouter<Weight>::AddEdge(ContractionState& state, const ChEdge& ch_edge) {
+    auto& outgoing = state.outgoing[ch_edge.from];
+    const auto parallel_edge = std::find_if(outgoing.begin(), outgoing.end(),
+        [this, &ch_edge](ChEdgeId ch_edge_id) { return ch_edges_[ch_edge_id].to == ch_edge.to; });
+    if (parallel_edge == outgoing.end()) {
+        outgoing.push_back(ch_edges_.size());
+        state.incoming[ch_edge.to].push_back(ch_edges_.size());
+    } else if (ch_edge.weight < ch_edges_[*parallel_edge].weight) {
+        auto& incoming = state.incoming[ch_edge.to];
+        *std::find(incoming.begin(), incoming.end(), *parallel_edge) = ch_edges_.size();
+        *parallel_edge = ch_edges_.size();
+    } else {
+        return;
+    }
+    ch_edges_.push_back(ch_edge);
+}
+
+template <typename Weight>
+void ContractionHierarchyRouter<Weight>::RemoveVertex(ContractionState& state, VertexId vertex) {
+    for (const ChEdgeId ch_edge_id : state.incoming[vertex]) {
+        const VertexId neighbor = ch_edges_[ch_edge_id].from;
+        auto& outgoing = state.outgoing[neighbor];
+        outgoing.erase(std::remove(outgoing.begin(), outgoing.end(), ch_edge_id), outgoing.end());
+        ++state.contracted_neighbors[neighbor];
+        state.levels[neighbor] = std::max(state.levels[neighbor], state.levels[vertex] + 1);
+    }
+    for (const ChEdgeId ch_edge_id : state.outgoing[vertex]) {
+        const VertexId neighbor = ch_edges_[ch_edge_id].to;
+        auto& incoming = state.incoming[neighbor];
+        incoming.erase(std::remove(incoming.begin(), incoming.end(), ch_edge_id), incoming.end());
+        ++state.contracted_neighbors[neighbor];
+        state.levels[neighbor] = std::max(state.levels[neighbor], state.levels[vertex] + 1);
+    }
+    // What is left around the vertex leads to higher ranked vertices only.
+    up_edges_[vertex] = std::move(state.outgoing[vertex]);
+    down_edges_[vertex] = std::move(state.incoming[vertex]);
+    state.outgoing[vertex].clear();
+    state.incoming[vertex].clear();
+}
+
+template <typename Weight>
+size_t ContractionHierarchyRouter<Weight>::ContractVertex(ContractionState& state,
+                                                          VertexId vertex, bool add_shortcuts) {
+    size_t shortcut_count = 0;
+    for (const ChEdgeId in_edge_id : state.incoming[vertex]) {
+        const ChEdge in_edge = ch_edges_[in_edge_id];
+        std::optional<Weight> max_weight;
+        for (const ChEdgeId out_edge_id : state.outgoing[vertex]) {
+            const ChEdge& out_edge = ch_edges_[out_edge_id];
+            if (out_edge.to == in_edge.from) {
+                continue;
+            }
+            const Weight weight = in_edge.weight + out_edge.weight;
+            if (!max_weight || *max_weight < weight) {
+                max_weight = weight;
+            }
+        }
+        if (!max_weight) {
+            continue;
+        }
+
+        RunWitnessSearch(state, in_edge.from, vertex, *max_weight);
+        for (const ChEdgeId out_edge_id : state.outgoing[vertex]) {
+            const ChEdge out_edge = ch_edges_[out_edge_id];
+            if (out_edge.to == in_edge.from) {
+                continue;
+            }
+            const Weight weight = in_edge.weight + out_edge.weight;
+            const auto& witness_distance = state.witness_distances[out_edge.to];
+            if (witness_distance && *witness_distance <= weight) {
+                continue;
+            }
+            ++shortcut_count;
+            if (add_shortcuts) {
+                AddEdge(state, {in_edge.from, out_edge.to, weight, std::nullopt,
+                                in_edge_id, out_edge_id});
+            }
+        }
+    }
+    return shortcut_count;
+}
+
+template <typename Weight>
+int64_t ContractionHierarchyRouter<Weight>::ComputePriority(ContractionState& state,
+                                                            VertexId vertex) {
+    const auto removed_edges = static_cast<int64_t>(state.incoming[vertex].size()
+                                                    + state.outgoing[vertex].size());
+    const auto shortcut_count = static_cast<int64_t>(ContractVertex(state, vertex, false));
+    return shortcut_count - removed_edges + state.contracted_neighbors[vertex]
+           + state.levels[vertex];
+}
+
+template <typename Weight>
+void ContractionHierarchyRouter<Weight>::BuildHierarchy(ContractionState& state) {
+    using PriorityItem = std::pair<int64_t, VertexId>;
+    std::priority_queue<PriorityItem, std::vector<PriorityItem>, std::greater<PriorityItem>> queue;
+    for (VertexId vertex = 0; vertex < graph_.GetVertexCount(); ++vertex) {
+        queue.push({ComputePriority(state, vertex), vertex});
+    }
+
+    size_t next_rank = 0;
+    while (!queue.empty()) {
+        const VertexId vertex = queue.top().second;
+        queue.pop();
+        // Priorities go stale as neighbors get contracted, so they are refreshed lazily.
+        const int64_t priority = ComputePriority(state, vertex);
+        if (!queue.empty() && priority > queue.top().first) {
+            queue.push({priority, vertex});
+            continue;
+        }
+
+        const size_t edge_count_before = ch_edges_.size();
+        ContractVertex(state, vertex, true);
+        shortcut_count_ += ch_edges_.size() - edge_count_before;
+        ranks_[vertex] = next_rank++;
+        RemoveVertex(state, vertex);
+    }
+}
+
+template <typename Weight>
+void ContractionHierarchyRouter<Weight>::UnpackEdge(ChEdgeId ch_edge_id,
+                                                    std::vector<EdgeId>& edges) const {
+    std::vector<ChEdgeId> stack{ch_edge_id};
+    while (!stack.empty()) {
+        const ChEdge& ch_edge = ch_edges_[stack.back()];
+        stack.pop_back();
+        if (ch_edge.original_edge) {
+            edges.push_back(*ch_edge.original_edge);
+        } else {
+            stack.push_back(ch_edge.second_child);
+            stack.push_back(ch_edge.first_child);
+        }
+    }
+}
+
+template <typename Weight>
+std::optional<typename ContractionHierarchyRouter<Weight>::RouteInfo>
+ContractionHierarchyRouter<Weight>::BuildRoute(VertexId from, VertexId to,
+                                               SearchStats* stats) const {
+    const size_t vertex_count = graph_.GetVertexCount();
+    if (from >= vertex_count || to >= vertex_count) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+
+    SearchSide forward(vertex_count);
+    SearchSide backward(vertex_count);
+    forward.distances[from] = ZERO_WEIGHT;
+    forward.queue.push({ZERO_WEIGHT, from});
+    backward.distances[to] = ZERO_WEIGHT;
+    backward.queue.push({ZERO_WEIGHT, to});
+
+    std::optional<Weight> best_weight;
+    VertexId meeting_vertex = from;
+    const auto is_done = [&best_weight](const SearchSide& side) {
+        return side.queue.empty() || (best_weight && side.queue.top().first >= *best_weight);
+    };
+
+    size_t settled_vertices = 0;
+    while (!is_done(forward) || !is_done(backward)) {
+        const bool is_forward = is_done(backward)
+                                || (!is_done(forward)
+                                    && forward.queue.top().first <= backward.queue.top().first);
+        SearchSide& side = is_forward ? forward : backward;
+        const SearchSide& other_side = is_forward ? backward : forward;
+        const auto [distance, vertex] = side.queue.top();
+        side.queue.pop();
+        if (distance > *side.distances[vertex]) {
+            continue;
+        }
+        ++settled_vertices;
+        if (other_side.distances[vertex]) {
+            const Weight weight = distance + *other_side.distances[vertex];
+            if (!best_weight || weight < *best_weight) {
+                best_weight = weight;
+                meeting_vertex = vertex;
+            }
+        }
+
+        // Stall-on-demand: a vertex reached more cheaply through a higher ranked
+        // neighbor cannot be on a shortest up-down route, so it is not expanded.
+        const auto& opposite_edges = is_forward ? down_edges_[vertex] : up_edges_[vertex];
+        const bool is_stalled = std::any_of(opposite_edges.begin(), opposite_edges.end(),
+            [&](ChEdgeId ch_edge_id) {
+                const ChEdge& ch_edge = ch_edges_[ch_edge_id];
+                const auto& neighbor_distance = side.distances[is_forward ? ch_edge.from
+                                                                          : ch_edge.to];
+                return neighbor_distance && *neighbor_distance + ch_edge.weight < distance;
+            });
+        if (is_stalled) {
+            continue;
+        }
+        for (const ChEdgeId ch_edge_id : is_forward ? up_edges_[vertex] : down_edges_[vertex]) {
+            const ChEdge& ch_edge = ch_edges_[ch_edge_id];
+            const VertexId next_vertex = is_forward ? ch_edge.to : ch_edge.from;
+            const Weight candidate = distance + ch_edge.weight;
+            auto& next_distance = side.distances[next_vertex];
+            if (!next_distance || candidate < *next_distance) {
+                next_distance = candidate;
+                side.edges[next_vertex] = ch_edge_id;
+                side.queue.push({candidate, next_vertex});
+            }
+        }
+    }
+    if (stats) {
+        stats->settled_vertices = settled_vertices;
+    }
+    if (!best_weight) {
+        return std::nullopt;
+    }
+
+    std::vector<ChEdgeId> path;
+    for (VertexId vertex = meeting_vertex; vertex != from;) {
+        path.push_back(*forward.edges[vertex]);
+        vertex = ch_edges_[path.back()].from;
+    }
+    std::reverse(path.begin(), path.end());
+    for (VertexId vertex = meeting_vertex; vertex != to;) {
+        path.push_back(*backward.edges[vertex]);
+        vertex = ch_edges_[path.back()].to;
+    }
+
+    std::vector<EdgeId> edges;
+    Weight weight = ZERO_WEIGHT;
+    for (const ChEdgeId ch_edge_id : path) {
+        UnpackEdge(ch_edge_id, edges);
+    }
+    for (const EdgeId edge_id : edges) {
+        weight += graph_.GetEdge(edge_id).weight;
+    }
+    return RouteInfo{weight, std::move(edges)};
+}
+
+}  // namespace graph
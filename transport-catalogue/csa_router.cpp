@@ -0,0 +1,141 @@
+#include "csa_router.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace transport_router {
+
+ConnectionScanRouter::ConnectionScanRouter(const BusLines& lines, double bus_velocity)
+    : bus_velocity_(bus_velocity)
+    , lines_(lines) {
+    for (const BusLine& line : lines.GetLines()) {
+        if (line.bus->departure_times.empty() || line.stops.size() < 2) {
+            continue;
+        }
+        AddTrips(line.bus, line.stops, line.forward_distances);
+        if (!line.bus->is_roundtrip) {
+            AddTrips(line.bus, line.GetReverseStops(), line.GetReverseDistances());
+        }
+    }
+    // Connections of one trip that depart and arrive together keep their order
+    // along the trip; zero length ones of different trips are rescanned in FindRoute.
+    std::stable_sort(connections_.begin(), connections_.end(),
+        [](const Connection& lhs, const Connection& rhs) {
+            return lhs.departure_time < rhs.departure_time
+                   || (lhs.departure_time == rhs.departure_time && lhs.arrival_time < rhs.arrival_time);
+        });
+}
+
+void ConnectionScanRouter::AddTrips(const transport_catalogue::Bus* bus
+                                    , const std::vector<size_t>& stops
+                                    , const std::vector<int64_t>& distances) {
+    for (const double first_departure : bus->departure_times) {
+        const uint32_t trip = static_cast<uint32_t>(trip_buses_.size());
+        trip_buses_.push_back(bus);
+        for (size_t position = 0; position + 1 < stops.size(); ++position) {
+            connections_.push_back({first_departure + static_cast<double>(distances[position]) / bus_velocity_
+                                   , first_departure + static_cast<double>(distances[position + 1]) / bus_velocity_
+                                   , static_cast<uint32_t>(stops[position])
+                                   , static_cast<uint32_t>(stops[position + 1])
+                                   , trip
+                                   , static_cast<uint32_t>(position)});
+        }
+    }
+}
+
+std::optional<std::vector<graph::Edge<double>>> ConnectionScanRouter::FindRoute(
+                                                    graph::VertexId vertex_from
+                                                    , graph::VertexId vertex_to
+                                                    , double departure_time) const {
+    const size_t stop_from = lines_.GetStopIndex(vertex_from);
+    const size_t stop_to = lines_.GetStopIndex(vertex_to);
+    std::vector<std::optional<double>> arrivals(lines_.GetStopCount());
+    std::vector<std::optional<Leg>> legs(lines_.GetStopCount());
+    // The connection each trip was first boarded at.
+    std::vector<size_t> trip_boardings(trip_buses_.size(), NO_CONNECTION);
+    arrivals[stop_from] = departure_time;
+
+    const auto first_connection = std::lower_bound(connections_.begin(), connections_.end(), departure_time,
+        [](const Connection& connection, double time) {
+            return connection.departure_time < time;
+        });
+    // Relaxes one connection and tells whether it boarded its trip or improved
+    // an arrival. A rider already on the trip stays on it; one who reaches the
+    // trip at an earlier stop boards there instead.
+    const auto scan_connection = [&](size_t index) {
+        const Connection& connection = connections_[index];
+        size_t& boarding = trip_boardings[connection.trip];
+        const auto& stop_arrival = arrivals[connection.stop_from];
+        bool changed = false;
+        if (stop_arrival && *stop_arrival <= connection.departure_time
+            && (boarding == NO_CONNECTION || connections_[boarding].position > connection.position)) {
+            boarding = index;
+            changed = true;
+        }
+        if (boarding == NO_CONNECTION || connections_[boarding].position > connection.position) {
+            return changed;
+        }
+        auto& arrival = arrivals[connection.stop_to];
+        if (!arrival || connection.arrival_time < *arrival) {
+            arrival = connection.arrival_time;
+            legs[connection.stop_to] = Leg{boarding, index};
+            changed = true;
+        }
+        return changed;
+    };
+
+    for (auto connection = first_connection; connection != connections_.end();) {
+        // Nothing departing later can arrive earlier.
+        if (arrivals[stop_to] && connection->departure_time >= *arrivals[stop_to]) {
+            break;
+        }
+        // Zero length connections departing together come first among those
+        // departing at that time, but may feed each other in any order across
+        // trips, so they are scanned again until nothing changes.
+        auto block_end = std::next(connection);
+        if (connection->arrival_time == connection->departure_time) {
+            while (block_end != connections_.end()
+                   && block_end->departure_time == connection->departure_time
+                   && block_end->arrival_time == connection->departure_time) {
+                ++block_end;
+            }
+        }
+        const size_t block_first = static_cast<size_t>(connection - connections_.begin());
+        const size_t block_last = static_cast<size_t>(block_end - connections_.begin());
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (size_t index = block_first; index < block_last; ++index) {
+                changed = scan_connection(index) || changed;
+            }
+            changed = changed && block_last - block_first > 1;
+        }
+        connection = block_end;
+    }
+    if (!arrivals[stop_to]) {
+        return std::nullopt;
+    }
+
+    std::vector<graph::Edge<double>> edges;
+    for (size_t stop = stop_to; stop != stop_from;) {
+        const Leg& leg = *legs[stop];
+        const Connection& board = connections_[leg.board_connection];
+        const Connection& alight = connections_[leg.alight_connection];
+        const size_t board_stop = board.stop_from;
+        edges.push_back({trip_buses_[board.trip]->id
+                        , alight.position + 1 - board.position
+                        , lines_.GetStopVertex(board_stop) + 1
+                        , lines_.GetStopVertex(stop)
+                        , alight.arrival_time - board.departure_time});
+        edges.push_back({lines_.GetStop(board_stop).id
+                        , 0
+                        , lines_.GetStopVertex(board_stop)
+                        , lines_.GetStopVertex(board_stop) + 1
+                        , board.departure_time - *arrivals[board_stop]});
+        stop = board_stop;
+    }
+    std::reverse(edges.begin(), edges.end());
+    return edges;
+}
+
+} // namespace transport_router
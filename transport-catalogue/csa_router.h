@@ -0,0 +1,63 @@
+#pragma once
+
+#include "bus_lines.h"
+#include "graph.h"
+#include "transport_catalogue.h"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace transport_router {
+
+// Earliest arrival routing over bus timetables with the Connection Scan
+// Algorithm. Every trip of every bus is cut into connections between its
+// consecutive stops, and all of them are kept in one array sorted by departure
+// time. A query scans that array once from the departure time on, so its cost
+// is bounded by the connections departing before the arrival, with no queue.
+// Buses without departure times take no part; trips run at bus_velocity and a
+// stop can be left by any trip departing no earlier than the arrival there.
+class ConnectionScanRouter {
+public:
+    // Keeps a reference to lines, which must outlive the router.
+    ConnectionScanRouter(const BusLines& lines, double bus_velocity);
+
+    // The route arriving first when leaving vertex_from at departure_time, in
+    // minutes after midnight. Routes come out as the edges TransportRouter::FillEdges
+    // would have created, with waits lasting until the boarded trip departs.
+    std::optional<std::vector<graph::Edge<double>>> FindRoute(graph::VertexId vertex_from
+                                                              , graph::VertexId vertex_to
+                                                              , double departure_time) const;
+
+private:
+    struct Connection {
+        double departure_time;
+        double arrival_time;
+        uint32_t stop_from;
+        uint32_t stop_to;
+        uint32_t trip;
+        // Position of stop_from along the trip, for span counts.
+        uint32_t position;
+    };
+
+    struct Leg {
+        size_t board_connection;
+        size_t alight_connection;
+    };
+
+    static constexpr size_t NO_CONNECTION = std::numeric_limits<size_t>::max();
+
+    void AddTrips(const transport_catalogue::Bus* bus
+                  , const std::vector<size_t>& stops
+                  , const std::vector<int64_t>& distances);
+
+    double bus_velocity_ = 0.0;
+    const BusLines& lines_;
+    // Bus of each trip.
+    std::vector<const transport_catalogue::Bus*> trip_buses_;
+    // Sorted by departure time.
+    std::vector<Connection> connections_;
+};
+
+} // namespace transport_router
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "graph.h"
+#include "router.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// Answers each query with its own Dijkstra search instead of precomputing
+// all pairs, so construction is linear in the graph size.
+template <typename Weight>
+class DijkstraRouter {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+public:
+    using RouteInfo = graph::RouteInfo<Weight>;
+
+    explicit DijkstraRouter(const Graph& graph);
+
+    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to,
+                                        SearchStats* stats = nullptr) const;
+
+    // Weights of the best routes from one vertex to each of the targets, in the
+    // same order. A single search serves all targets and stops once they are settled.
+    std::vector<std::optional<Weight>> BuildWeights(VertexId from, const std::vector<VertexId>& targets,
+                                                    SearchStats* stats = nullptr) const;
+
+    // Every vertex whose best route from `from` weighs at most max_weight, with
+    // that weight, in order of weight. The search stops at the limit.
+    std::vector<std::pair<VertexId, Weight>> BuildReachable(VertexId from, Weight max_weight,
+                                                            SearchStats* stats = nullptr) const;
+
+private:
+    using QueueItem = std::pair<Weight, VertexId>;
+    using Queue = std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>>;
+
+    static constexpr Weight ZERO_WEIGHT{};
+    const Graph& graph_;
+};
+
+template <typename Weight>
+DijkstraRouter<Weight>::DijkstraRouter(const Graph& graph)
+    : graph_(graph)
+{
+    CheckNonNegativeWeights(graph);
+}
+
+template <typename Weight>
+std::optional<typename DijkstraRouter<Weight>::RouteInfo> DijkstraRouter<Weight>::BuildRoute(
+                                                                    VertexId from,
+                                                                    VertexId to,
+                                                                    SearchStats* stats) const {
+    const size_t vertex_count = graph_.GetVertexCount();
+    if (from >= vertex_count || to >= vertex_count) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+
+    std::vector<std::optional<Weight>> weights(vertex_count);
+    std::vector<std::optional<EdgeId>> prev_edges(vertex_count);
+    Queue queue;
+
+    weights[from] = ZERO_WEIGHT;
+    queue.push({ZERO_WEIGHT, from});
+
+    size_t settled_vertices = 0;
+    while (!queue.empty()) {
+        const auto [weight, vertex] = queue.top();
+        queue.pop();
+        if (weight > *weights[vertex]) {
+            continue;
+        }
+        ++settled_vertices;
+        if (vertex == to) {
+            break;
+        }
+        for (const EdgeId edge_id : graph_.GetIncidentEdges(vertex)) {
+            const auto& edge = graph_.GetEdge(edge_id);
+            const Weight candidate_weight = weight + edge.weight;
+            auto& target_weight = weights[edge.to];
+            if (!target_weight || candidate_weight < *target_weight) {
+                target_weight = candidate_weight;
+                prev_edges[edge.to] = edge_id;
+                queue.push({candidate_weight, edge.to});
+            }
+        }
+    }
+
+    if (stats) {
+        stats->settled_vertices = settled_vertices;
+    }
+
+    if (!weights[to]) {
+        return std::nullopt;
+    }
+    std::vector<EdgeId> edges;
+    for (std::optional<EdgeId> edge_id = prev_edges[to];
+         edge_id;
+         edge_id = prev_edges[graph_.GetEdge(*edge_id).from])
+    {
+        edges.push_back(*edge_id);
+    }
+    std::reverse(edges.begin(), edges.end());
+
+    return RouteInfo{*weights[to], std::move(edges)};
+}
+
+template <typename Weight>
+std::vector<std::optional<Weight>> DijkstraRouter<Weight>::BuildWeights(
+                                                    VertexId from,
+                                                    const std::vector<VertexId>& targets,
+                                                    SearchStats* stats) const {
+    const size_t vertex_count = graph_.GetVertexCount();
+    if (from >= vertex_count) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    std::vector<bool> is_pending(vertex_count, false);
+    size_t pending_count = 0;
+    for (const VertexId target : targets) {
+        if (target >= vertex_count) {
+            throw std::out_of_range("Vertex id is out of range");
+        }
+        if (!is_pending[target]) {
+            is_pending[target] = true;
+            ++pending_count;
+        }
+    }
+
+    std::vector<std::optional<Weight>> weights(vertex_count);
+    Queue queue;
+    weights[from] = ZERO_WEIGHT;
+    queue.push({ZERO_WEIGHT, from});
+
+    size_t settled_vertices = 0;
+    while (!queue.empty() && pending_count > 0) {
+        const auto [weight, vertex] = queue.top();
+        queue.pop();
+        if (weight > *weights[vertex]) {
+            continue;
+        }
+        ++settled_vertices;
+        if (is_pending[vertex]) {
+            is_pending[vertex] = false;
+            --pending_count;
+        }
+        for (const EdgeId edge_id : graph_.GetIncidentEdges(vertex)) {
+            const auto& edge = graph_.GetEdge(edge_id);
+            const Weight candidate_weight = weight + edge.weight;
+            auto& target_weight = weights[edge.to];
+            if (!target_weight || candidate_weight < *target_weight) {
+                target_weight = candidate_weight;
+                queue.push({candidate_weight, edge.to});
+            }
+        }
+    }
+
+    if (stats) {
+        stats->settled_vertices = settled_vertices;
+    }
+
+    std::vector<std::optional<Weight>> result;
+    result.reserve(targets.size());
+    for (const VertexId target : targets) {
+        result.push_back(weights[target]);
+    }
+    return result;
+}
+
+template <typename Weight>
+std::vector<std::pair<VertexId, Weight>> DijkstraRouter<Weight>::BuildReachable(
+                                                    VertexId from,
+                                                    Weight max_weight,
+                                                    SearchStats* stats) const {
+    const size_t vertex_count = graph_.GetVertexCount();
+    if (from >= vertex_count) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+
+    std::vector<std::pair<VertexId, Weight>> result;
+    if (max_weight < ZERO_WEIGHT) {
+        return result;
+    }
+    std::vector<std::optional<Weight>> weights(vertex_count);
+    Queue queue;
+    weights[from] = ZERO_WEIGHT;
+    queue.push({ZERO_WEIGHT, from});
+
+    while (!queue.empty()) {
+        const auto [weight, vertex] = queue.top();
+        queue.pop();
+        if (weight > *weights[vertex]) {
+            continue;
+        }
+        result.push_back({vertex, weight});
+        for (const EdgeId edge_id : graph_.GetIncidentEdges(vertex)) {
+            const auto& edge = graph_.GetEdge(edge_id);
+            const Weight candidate_weight = weight + edge.weight;
+            auto& target_weight = weights[edge.to];
+            // Routes over the limit are never reported, so they need not be queued.
+            if (!(max_weight < candidate_weight)
+                && (!target_weight || candidate_weight < *target_weight)) {
+                target_weight = candidate_weight;
+                queue.push({candidate_weight, edge.to});
+            }
+        }
+    }
+
+    if (stats) {
+        stats->settled_vertices = result.size();
+    }
+    return result;
+}
+
+}  // namespace graph
@@ -2,20 +2,30 @@
 
 #include "geo.h"
 
-#include <string>
+#include <cstdint>
+#include <string_view>
 #include <vector>
 
 namespace transport_catalogue {
 
 struct Stop {
-    std::string name;
+    // Kept in the name arena of the catalogue.
+    std::string_view name;
     geo::Coordinates coordinates;
+    // Position of the stop in the catalogue, see TransportCatalogue::GetStopById.
+    uint32_t id = 0;
 };
 
 struct Bus {
-    std::string name;
+    // Kept in the name arena of the catalogue.
+    std::string_view name;
     std::vector<const Stop*> route_stops;
     bool is_roundtrip = false;
+    // Minutes after midnight at which trips leave the first stop, and the last
+    // stop too unless the bus is a roundtrip. Empty when the bus has no timetable.
+    std::vector<double> departure_times;
+    // Position of the bus in the catalogue, see TransportCatalogue::GetBusById.
+    uint32_t id = 0;
 };
 
 struct BusRouteInfo {
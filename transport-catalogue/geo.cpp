@@ -1,6 +1,7 @@
 #define _USE_MATH_DEFINES
 #include "geo.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace geo {
@@ -24,4 +25,15 @@ double ComputeGeoDistance(Coordinates from, Coordinates to) {
         * EARTH_RADIUS;
 }
 
+double ComputeHaversineDistance(Coordinates from, Coordinates to) {
+    using namespace std;
+    const double dr = M_PI / 180.0;
+    const int EARTH_RADIUS = 6371000;
+    const double sin_half_lat = sin((to.lat - from.lat) * dr / 2);
+    const double sin_half_lng = sin((to.lng - from.lng) * dr / 2);
+    const double haversine = min(1.0, sin_half_lat * sin_half_lat
+                                      + cos(from.lat * dr) * cos(to.lat * dr) * sin_half_lng * sin_half_lng);
+    return 2 * atan2(sqrt(haversine), sqrt(1 - haversine)) * EARTH_RADIUS;
+}
+
 }  // namespace geo
\ No newline at end of file
@@ -1,17 +1,22 @@
-#pragma once
-
-namespace geo {
-
-struct Coordinates {
-    Coordinates() = default;
-    Coordinates(double latt, double lngt)
-    : lat(latt), lng(lngt) {}
-    double lat;
-    double lng;
-    bool operator==(const Coordinates& other) const;
-    bool operator!=(const Coordinates& other) const;
-};
-
-double ComputeGeoDistance(Coordinates from, Coordinates to);
-
+#pragma once
+
+namespace geo {
+
+struct Coordinates {
+    Coordinates() = default;
+    Coordinates(double latt, double lngt)
+    : lat(latt), lng(lngt) {}
+    double lat;
+    double lng;
+    bool operator==(const Coordinates& other) const;
+    bool operator!=(const Coordinates& other) const;
+};
+
+double ComputeGeoDistance(Coordinates from, Coordinates to);
+
+// The same distance by the haversine formula, which stays accurate down to
+// points millimetres apart, where the arc cosine above loses precision or
+// returns NaN.
+double ComputeHaversineDistance(Coordinates from, Coordinates to);
+
 }  // namespace geo
\ No newline at end of file
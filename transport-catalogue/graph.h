@@ -2,7 +2,11 @@
 
 #include "ranges.h"
 
+#include <cstdint>
 #include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace graph {
@@ -12,8 +16,10 @@ using EdgeId = size_t;
 
 template <typename Weight>
 struct Edge {
-    std::string name;
-    size_t span_count;
+    // Caller-defined id of what the edge stands for, kept as an integer so
+    // building millions of edges does not allocate.
+    uint32_t name_id;
+    uint32_t span_count;
     VertexId from;
     VertexId to;
     Weight weight;
@@ -23,21 +29,39 @@ template <typename Weight>
 class DirectedWeightedGraph {
 private:
     using IncidenceList = std::vector<EdgeId>;
-    using IncidentEdgesRange = ranges::Range<typename IncidenceList::const_iterator>;
+    using IncidentEdgesRange = ranges::Range<const EdgeId*>;
 
 public:
     DirectedWeightedGraph() = default;
     explicit DirectedWeightedGraph(size_t vertex_count);
     EdgeId AddEdge(const Edge<Weight>& edge);
+    // Adds the edges in order, as AddEdge one by one would, reserving room for all of them first.
+    void AddEdges(const std::vector<Edge<Weight>>& edges);
 
     size_t GetVertexCount() const;
     size_t GetEdgeCount() const;
     const Edge<Weight>& GetEdge(EdgeId edge_id) const;
     IncidentEdgesRange GetIncidentEdges(VertexId vertex) const;
 
+    // Converts the graph to compressed sparse row form: edges are renumbered in
+    // order of their source vertex, so the incident edges of every vertex are
+    // adjacent both in the edge array and in one shared id array. Ids returned
+    // by AddEdge are invalidated and no edges can be added afterwards.
+    void Freeze();
+    bool IsFrozen() const;
+    // Whether any edge added so far has a weight below Weight{}, kept up to
+    // date by AddEdge and AddEdges so routers need not scan the edges for it.
+    bool HasNegativeWeights() const;
+
 private:
     std::vector<Edge<Weight>> edges_;
+    // Per-vertex lists while the graph is being built, cleared by Freeze.
     std::vector<IncidenceList> incidence_lists_;
+    // The incident edges of vertex v are incident_edges_[incidence_offsets_[v]]
+    // up to incident_edges_[incidence_offsets_[v + 1]] once the graph is frozen.
+    std::vector<size_t> incidence_offsets_;
+    std::vector<EdgeId> incident_edges_;
+    bool has_negative_weights_ = false;
 };
 
 template <typename Weight>
@@ -47,15 +71,39 @@ DirectedWeightedGraph<Weight>::DirectedWeightedGraph(size_t vertex_count)
 
 template <typename Weight>
 EdgeId DirectedWeightedGraph<Weight>::AddEdge(const Edge<Weight>& edge) {
+    if (IsFrozen()) {
+        throw std::logic_error("Cannot add edges to a frozen graph");
+    }
     edges_.push_back(edge);
+    has_negative_weights_ = has_negative_weights_ || edge.weight < Weight{};
     const EdgeId id = edges_.size() - 1;
     incidence_lists_.at(edge.from).push_back(id);
     return id;
 }
 
+template <typename Weight>
+void DirectedWeightedGraph<Weight>::AddEdges(const std::vector<Edge<Weight>>& edges) {
+    if (IsFrozen()) {
+        throw std::logic_error("Cannot add edges to a frozen graph");
+    }
+    std::vector<size_t> added_counts(incidence_lists_.size(), 0);
+    for (const Edge<Weight>& edge : edges) {
+        ++added_counts.at(edge.from);
+    }
+    for (size_t vertex = 0; vertex < incidence_lists_.size(); ++vertex) {
+        incidence_lists_[vertex].reserve(incidence_lists_[vertex].size() + added_counts[vertex]);
+    }
+    edges_.reserve(edges_.size() + edges.size());
+    for (const Edge<Weight>& edge : edges) {
+        incidence_lists_[edge.from].push_back(edges_.size());
+        edges_.push_back(edge);
+        has_negative_weights_ = has_negative_weights_ || edge.weight < Weight{};
+    }
+}
+
 template <typename Weight>
 size_t DirectedWeightedGraph<Weight>::GetVertexCount() const {
-    return incidence_lists_.size();
+    return IsFrozen() ? incidence_offsets_.size() - 1 : incidence_lists_.size();
 }
 
 template <typename Weight>
@@ -71,6 +119,81 @@ const Edge<Weight>& DirectedWeightedGraph<Weight>::GetEdge(EdgeId edge_id) const
 template <typename Weight>
 typename DirectedWeightedGraph<Weight>::IncidentEdgesRange
 DirectedWeightedGraph<Weight>::GetIncidentEdges(VertexId vertex) const {
-    return ranges::AsRange(incidence_lists_.at(vertex));
+    if (IsFrozen()) {
+        const EdgeId* const edge_ids = incident_edges_.data();
+        return {edge_ids + incidence_offsets_.at(vertex), edge_ids + incidence_offsets_.at(vertex + 1)};
+    }
+    const IncidenceList& edge_ids = incidence_lists_.at(vertex);
+    return {edge_ids.data(), edge_ids.data() + edge_ids.size()};
+}
+
+template <typename Weight>
+void DirectedWeightedGraph<Weight>::Freeze() {
+    if (IsFrozen()) {
+        return;
+    }
+    std::vector<Edge<Weight>> sorted_edges;
+    sorted_edges.reserve(edges_.size());
+    incidence_offsets_.reserve(incidence_lists_.size() + 1);
+    for (const IncidenceList& edge_ids : incidence_lists_) {
+        incidence_offsets_.push_back(sorted_edges.size());
+        for (const EdgeId edge_id : edge_ids) {
+            sorted_edges.push_back(std::move(edges_[edge_id]));
+        }
+    }
+    incidence_offsets_.push_back(sorted_edges.size());
+
+    edges_ = std::move(sorted_edges);
+    incident_edges_.resize(edges_.size());
+    std::iota(incident_edges_.begin(), incident_edges_.end(), EdgeId{0});
+    std::vector<IncidenceList>().swap(incidence_lists_);
+}
+
+template <typename Weight>
+bool DirectedWeightedGraph<Weight>::IsFrozen() const {
+    return !incidence_offsets_.empty();
 }
+
+template <typename Weight>
+bool DirectedWeightedGraph<Weight>::HasNegativeWeights() const {
+    return has_negative_weights_;
+}
+
+// Throws std::domain_error if the graph has an edge of negative weight, which
+// no router here can search over.
+template <typename Weight>
+void CheckNonNegativeWeights(const DirectedWeightedGraph<Weight>& graph) {
+    if (graph.HasNegativeWeights()) {
+        throw std::domain_error("Edges' weights should be non-negative");
+    }
+}
+
+// FNV-1a hash over the vertex count and every edge in id order. Two graphs with
+// the same fingerprint produce the same routes for the same vertex and edge ids.
+template <typename Weight>
+uint64_t ComputeGraphFingerprint(const DirectedWeightedGraph<Weight>& graph) {
+    uint64_t hash = 14695981039346656037ULL;
+    const auto add_bytes = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    };
+    const auto add_value = [&add_bytes](auto value) {
+        add_bytes(&value, sizeof(value));
+    };
+
+    add_value(static_cast<uint64_t>(graph.GetVertexCount()));
+    add_value(static_cast<uint64_t>(graph.GetEdgeCount()));
+    for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+        const auto& edge = graph.GetEdge(edge_id);
+        add_value(static_cast<uint64_t>(edge.from));
+        add_value(static_cast<uint64_t>(edge.to));
+        add_value(edge.span_count);
+        add_value(edge.weight);
+        add_value(edge.name_id);
+    }
+    return hash;
+}
+
 }  // namespace graph
\ No newline at end of file
@@ -0,0 +1,456 @@
+#pragma once
+
+#include "graph.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// Hub labels for route weights between query vertices. Every query vertex keeps
+// an outgoing label, the hubs it reaches with their weights, and an incoming
+// label, the hubs reaching it, so that some hub lies on a shortest route for
+// every pair. A query intersects two labels sorted by hub rank without touching
+// the graph. Labels are built by pruned Dijkstra searches from every vertex in
+// order of decreasing degree and stored as flat arrays that can be mapped from
+// a file as is.
+template <typename Weight>
+class HubLabelIndex {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+public:
+    // Labels are kept for query_vertices only, the vertices routes start and end at.
+    HubLabelIndex(const Graph& graph, const std::vector<VertexId>& query_vertices);
+
+    // Weight of the fastest route between two query vertices, nullopt if there is none.
+    std::optional<Weight> ComputeWeight(VertexId from, VertexId to) const;
+
+    size_t GetLabelEntryCount() const;
+
+    // Writes the labels to a versioned binary file tagged with the graph and
+    // query vertices fingerprints. Returns false if the file could not be written.
+    bool SaveToFile(const std::string& path) const;
+
+    // Maps a file written by SaveToFile without parsing it. Returns nullptr if
+    // the file is missing, has another format version or was built for another
+    // graph or other query vertices.
+    static std::unique_ptr<HubLabelIndex> LoadFromFile(const Graph& graph,
+                                                       const std::vector<VertexId>& query_vertices,
+                                                       const std::string& path);
+
+private:
+    using Offset = uint32_t;
+    using HubRank = uint32_t;
+    using QueueItem = std::pair<Weight, VertexId>;
+    using Queue = std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>>;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t weight_size;
+        uint64_t vertex_count;
+        uint64_t edge_count;
+        uint64_t graph_fingerprint;
+        uint64_t query_fingerprint;
+        uint64_t outgoing_entry_count;
+        uint64_t incoming_entry_count;
+    };
+    static constexpr char FILE_MAGIC[8] = {'T', 'C', 'H', 'U', 'B', 'L', 'B', '\0'};
+    static constexpr uint32_t FILE_VERSION = 1;
+    static constexpr size_t FILE_ALIGNMENT = 64;
+
+    static constexpr Weight ZERO_WEIGHT{};
+    static constexpr Weight NO_ROUTE = std::numeric_limits<Weight>::has_infinity
+                                           ? std::numeric_limits<Weight>::infinity()
+                                           : std::numeric_limits<Weight>::max();
+
+    // Labels while they are being built, one per vertex and direction.
+    struct Label {
+        std::vector<HubRank> hubs;
+        std::vector<Weight> weights;
+    };
+
+    // A flat set of labels: the label of vertex v holds hubs[offsets[v]] up to
+    // hubs[offsets[v + 1]] and the matching weights.
+    struct LabelArrays {
+        const Offset* offsets = nullptr;
+        const HubRank* hubs = nullptr;
+        const Weight* weights = nullptr;
+    };
+
+    static size_t AlignFileOffset(size_t offset) {
+        return (offset + FILE_ALIGNMENT - 1) / FILE_ALIGNMENT * FILE_ALIGNMENT;
+    }
+
+    static uint64_t ComputeQueryFingerprint(const std::vector<VertexId>& query_vertices);
+
+    // Byte offsets of the six arrays in the file, in the order they are written.
+    static std::vector<size_t> GetFileLayout(size_t vertex_count, size_t outgoing_entry_count,
+                                             size_t incoming_entry_count);
+
+    HubLabelIndex(const Graph& graph, mapped_file::MappedFile file);
+
+    // Weight through the best hub the two labels share, NO_ROUTE if they share none.
+    static Weight IntersectLabels(const HubRank* from_hubs, const Weight* from_weights, size_t from_size,
+                                  const HubRank* to_hubs, const Weight* to_weights, size_t to_size);
+
+    // One pruned search from the vertex of the given rank, along edges or
+    // against them. Reached vertices whose weight the labels built so far do
+    // not already give get the hub added to their label and are expanded.
+    void PruneSearch(const std::vector<size_t>& offsets, const std::vector<EdgeId>& edges, bool is_forward,
+                     HubRank rank, VertexId hub, std::vector<Label>& outgoing, std::vector<Label>& incoming,
+                     std::vector<Weight>& distances, std::vector<Weight>& hub_weights) const;
+
+    void FlattenLabels(const std::vector<Label>& labels, const std::vector<bool>& is_query_vertex,
+                       std::vector<Offset>& offsets, std::vector<HubRank>& hubs,
+                       std::vector<Weight>& weights) const;
+
+    const Graph& graph_;
+    uint64_t query_fingerprint_ = 0;
+    std::vector<Offset> outgoing_offsets_;
+    std::vector<HubRank> outgoing_hubs_;
+    std::vector<Weight> outgoing_weights_;
+    std::vector<Offset> incoming_offsets_;
+    std::vector<HubRank> incoming_hubs_;
+    std::vector<Weight> incoming_weights_;
+    // Labels loaded by LoadFromFile live in file_ and the vectors stay empty.
+    mapped_file::MappedFile file_;
+    LabelArrays outgoing_;
+    LabelArrays incoming_;
+    size_t outgoing_entry_count_ = 0;
+    size_t incoming_entry_count_ = 0;
+};
+
+template <typename Weight>
+HubLabelIndex<Weight>::HubLabelIndex(const Graph& graph, const std::vector<VertexId>& query_vertices)
+    : graph_(graph)
+    , query_fingerprint_(ComputeQueryFingerprint(query_vertices))
+{
+    CheckNonNegativeWeights(graph);
+    const size_t vertex_count = graph.GetVertexCount();
+    std::vector<size_t> incoming_offsets(vertex_count + 1, 0);
+    std::vector<EdgeId> incoming_edges(graph.GetEdgeCount());
+    std::vector<size_t> outgoing_offsets(vertex_count + 1, 0);
+    std::vector<EdgeId> outgoing_edges;
+    outgoing_edges.reserve(graph.GetEdgeCount());
+    for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+        for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
+            const auto& edge = graph.GetEdge(edge_id);
+            ++incoming_offsets[edge.to + 1];
+            outgoing_edges.push_back(edge_id);
+        }
+        outgoing_offsets[vertex + 1] = outgoing_edges.size();
+    }
+    std::partial_sum(incoming_offsets.begin(), incoming_offsets.end(), incoming_offsets.begin());
+    std::vector<size_t> positions(incoming_offsets.begin(), incoming_offsets.end() - 1);
+    for (const EdgeId edge_id : outgoing_edges) {
+        incoming_edges[positions[graph.GetEdge(edge_id).to]++] = edge_id;
+    }
+
+    // Well connected vertices cover the most routes, so they become hubs first
+    // and prune the searches of everyone after them.
+    std::vector<VertexId> order(vertex_count);
+    std::iota(order.begin(), order.end(), VertexId{0});
+    std::stable_sort(order.begin(), order.end(), [&](VertexId lhs, VertexId rhs) {
+        const auto degree = [&](VertexId vertex) {
+            return (outgoing_offsets[vertex + 1] - outgoing_offsets[vertex])
+                   + (incoming_offsets[vertex + 1] - incoming_offsets[vertex]);
+        };
+        return degree(lhs) > degree(rhs);
+    });
+
+    std::vector<Label> outgoing(vertex_count);
+    std::vector<Label> incoming(vertex_count);
+    std::vector<Weight> distances(vertex_count, NO_ROUTE);
+    std::vector<Weight> hub_weights(vertex_count, NO_ROUTE);
+    for (size_t rank = 0; rank < vertex_count; ++rank) {
+        PruneSearch(outgoing_offsets, outgoing_edges, true, static_cast<HubRank>(rank), order[rank],
+                    outgoing, incoming, distances, hub_weights);
+        PruneSearch(incoming_offsets, incoming_edges, false, static_cast<HubRank>(rank), order[rank],
+                    outgoing, incoming, distances, hub_weights);
+    }
+
+    std::vector<bool> is_query_vertex(vertex_count, false);
+    for (const VertexId vertex : query_vertices) {
+        is_query_vertex.at(vertex) = true;
+    }
+    FlattenLabels(outgoing, is_query_vertex, outgoing_offsets_, outgoing_hubs_, outgoing_weights_);
+    FlattenLabels(incoming, is_query_vertex, incoming_offsets_, incoming_hubs_, incoming_weights_);
+    outgoing_ = {outgoing_offsets_.data(), outgoing_hubs_.data(), outgoing_weights_.data()};
+    incoming_ = {incoming_offsets_.data(), incoming_hubs_.data(), incoming_weights_.data()};
+    outgoing_entry_count_ = outgoing_hubs_.size();
+    incoming_entry_count_ = incoming_hubs_.size();
+}
+
+template <typename Weight>
+void HubLabelIndex<Weight>::PruneSearch(const std::vector<size_t>& offsets,
+                                        const std::vector<EdgeId>& edges,
+                                        bool is_forward,
+                                        HubRank rank,
+                                        VertexId hub,
+                                        std::vector<Label>& outgoing,
+                                        std::vector<Label>& incoming,
+                                        std::vector<Weight>& distances,
+                                        std::vector<Weight>& hub_weights) const {
+    // A forward search finds routes from the hub, which the hub's outgoing label
+    // and the reached vertex's incoming label already cover in part; a backward
+    // search is the mirror image.
+    const Label& hub_label = is_forward ? outgoing[hub] : incoming[hub];
+    std::vector<Label>& reached_labels = is_forward ? incoming : outgoing;
+    for (size_t i = 0; i < hub_label.hubs.size(); ++i) {
+        hub_weights[hub_label.hubs[i]] = hub_label.weights[i];
+    }
+
+    std::vector<VertexId> touched{hub};
+    Queue queue;
+    distances[hub] = ZERO_WEIGHT;
+    queue.push({ZERO_WEIGHT, hub});
+    while (!queue.empty()) {
+        const auto [distance, vertex] = queue.top();
+        queue.pop();
+        if (distance > distances[vertex]) {
+            continue;
+        }
+        Label& label = reached_labels[vertex];
+        bool is_covered = false;
+        for (size_t i = 0; i < label.hubs.size() && !is_covered; ++i) {
+            const Weight through_weight = hub_weights[label.hubs[i]];
+            is_covered = through_weight != NO_ROUTE && through_weight + label.weights[i] <= distance;
+        }
+        if (is_covered) {
+            continue;
+        }
+        label.hubs.push_back(rank);
+        label.weights.push_back(distance);
+
+        for (size_t position = offsets[vertex]; position < offsets[vertex + 1]; ++position) {
+            const auto& edge = graph_.GetEdge(edges[position]);
+            const VertexId next = is_forward ? edge.to : edge.from;
+            const Weight candidate = distance + edge.weight;
+            if (candidate < distances[next]) {
+                if (distances[next] == NO_ROUTE) {
+                    touched.push_back(next);
+                }
+                distances[next] = candidate;
+                queue.push({candidate, next});
+            }
+        }
+    }
+
+    for (const VertexId vertex : touched) {
+        distances[vertex] = NO_ROUTE;
+    }
+    for (const HubRank hub_rank : hub_label.hubs) {
+        hub_weights[hub_rank] = NO_ROUTE;
+    }
+}
+
+template <typename Weight>
+void HubLabelIndex<Weight>::FlattenLabels(const std::vector<Label>& labels,
+                                          const std::vector<bool>& is_query_vertex,
+                                          std::vector<Offset>& offsets,
+                                          std::vector<HubRank>& hubs,
+                                          std::vector<Weight>& weights) const {
+    size_t entry_count = 0;
+    for (VertexId vertex = 0; vertex < labels.size(); ++vertex) {
+        if (is_query_vertex[vertex]) {
+            entry_count += labels[vertex].hubs.size();
+        }
+    }
+    if (entry_count >= std::numeric_limits<Offset>::max()) {
+        throw std::length_error("Too many hub label entries");
+    }
+    offsets.assign(1, 0);
+    offsets.reserve(labels.size() + 1);
+    hubs.reserve(entry_count);
+    weights.reserve(entry_count);
+    for (VertexId vertex = 0; vertex < labels.size(); ++vertex) {
+        if (is_query_vertex[vertex]) {
+            hubs.insert(hubs.end(), labels[vertex].hubs.begin(), labels[vertex].hubs.end());
+            weights.insert(weights.end(), labels[vertex].weights.begin(), labels[vertex].weights.end());
+        }
+        offsets.push_back(static_cast<Offset>(hubs.size()));
+    }
+}
+
+template <typename Weight>
+Weight HubLabelIndex<Weight>::IntersectLabels(const HubRank* from_hubs, const Weight* from_weights,
+                                              size_t from_size, const HubRank* to_hubs,
+                                              const Weight* to_weights, size_t to_size) {
+    Weight best = NO_ROUTE;
+    size_t from_index = 0;
+    size_t to_index = 0;
+    while (from_index < from_size && to_index < to_size) {
+        if (from_hubs[from_index] < to_hubs[to_index]) {
+            ++from_index;
+        } else if (to_hubs[to_index] < from_hubs[from_index]) {
+            ++to_index;
+        } else {
+            best = std::min(best, from_weights[from_index++] + to_weights[to_index++]);
+        }
+    }
+    return best;
+}
+
+template <typename Weight>
+std::optional<Weight> HubLabelIndex<Weight>::ComputeWeight(VertexId from, VertexId to) const {
+    if (from >= graph_.GetVertexCount() || to >= graph_.GetVertexCount()) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    if (from == to) {
+        return ZERO_WEIGHT;
+    }
+    const Offset from_begin = outgoing_.offsets[from];
+    const Offset to_begin = incoming_.offsets[to];
+    const Weight weight = IntersectLabels(outgoing_.hubs + from_begin, outgoing_.weights + from_begin,
+                                          outgoing_.offsets[from + 1] - from_begin,
+                                          incoming_.hubs + to_begin, incoming_.weights + to_begin,
+                                          incoming_.offsets[to + 1] - to_begin);
+    if (weight == NO_ROUTE) {
+        return std::nullopt;
+    }
+    return weight;
+}
+
+template <typename Weight>
+size_t HubLabelIndex<Weight>::GetLabelEntryCount() const {
+    return outgoing_entry_count_ + incoming_entry_count_;
+}
+
+template <typename Weight>
+uint64_t HubLabelIndex<Weight>::ComputeQueryFingerprint(const std::vector<VertexId>& query_vertices) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const VertexId vertex : query_vertices) {
+        const auto value = static_cast<uint64_t>(vertex);
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+        for (size_t i = 0; i < sizeof(value); ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+template <typename Weight>
+std::vector<size_t> HubLabelIndex<Weight>::GetFileLayout(size_t vertex_count,
+                                                         size_t outgoing_entry_count,
+                                                         size_t incoming_entry_count) {
+    const size_t array_sizes[] = {
+        (vertex_count + 1) * sizeof(Offset), outgoing_entry_count * sizeof(HubRank),
+        outgoing_entry_count * sizeof(Weight), (vertex_count + 1) * sizeof(Offset),
+        incoming_entry_count * sizeof(HubRank), incoming_entry_count * sizeof(Weight)};
+    // The last element is the file size.
+    std::vector<size_t> layout{AlignFileOffset(sizeof(FileHeader))};
+    for (const size_t array_size : array_sizes) {
+        layout.push_back(AlignFileOffset(layout.back() + array_size));
+    }
+    return layout;
+}
+
+template <typename Weight>
+HubLabelIndex<Weight>::HubLabelIndex(const Graph& graph, mapped_file::MappedFile file)
+    : graph_(graph)
+    , file_(std::move(file))
+{
+    FileHeader header;
+    std::copy(file_.GetData(), file_.GetData() + sizeof(header), reinterpret_cast<std::byte*>(&header));
+    query_fingerprint_ = header.query_fingerprint;
+    outgoing_entry_count_ = header.outgoing_entry_count;
+    incoming_entry_count_ = header.incoming_entry_count;
+    const auto layout = GetFileLayout(header.vertex_count, outgoing_entry_count_, incoming_entry_count_);
+    const std::byte* data = file_.GetData();
+    outgoing_ = {reinterpret_cast<const Offset*>(data + layout[0]),
+                 reinterpret_cast<const HubRank*>(data + layout[1]),
+                 reinterpret_cast<const Weight*>(data + layout[2])};
+    incoming_ = {reinterpret_cast<const Offset*>(data + layout[3]),
+                 reinterpret_cast<const HubRank*>(data + layout[4]),
+                 reinterpret_cast<const Weight*>(data + layout[5])};
+}
+
+template <typename Weight>
+bool HubLabelIndex<Weight>::SaveToFile(const std::string& path) const {
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream output(temp_path, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            return false;
+        }
+        FileHeader header{};
+        std::copy(std::begin(FILE_MAGIC), std::end(FILE_MAGIC), header.magic);
+        header.version = FILE_VERSION;
+        header.weight_size = sizeof(Weight);
+        header.vertex_count = graph_.GetVertexCount();
+        header.edge_count = graph_.GetEdgeCount();
+        header.graph_fingerprint = ComputeGraphFingerprint(graph_);
+        header.query_fingerprint = query_fingerprint_;
+        header.outgoing_entry_count = outgoing_entry_count_;
+        header.incoming_entry_count = incoming_entry_count_;
+
+        const size_t offset_count = graph_.GetVertexCount() + 1;
+        const std::pair<const void*, size_t> arrays[] = {
+            {outgoing_.offsets, offset_count * sizeof(Offset)},
+            {outgoing_.hubs, outgoing_entry_count_ * sizeof(HubRank)},
+            {outgoing_.weights, outgoing_entry_count_ * sizeof(Weight)},
+            {incoming_.offsets, offset_count * sizeof(Offset)},
+            {incoming_.hubs, incoming_entry_count_ * sizeof(HubRank)},
+            {incoming_.weights, incoming_entry_count_ * sizeof(Weight)}};
+        const auto write_padding = [&output](size_t written) {
+            static const char padding[FILE_ALIGNMENT] = {};
+            output.write(padding, AlignFileOffset(written) - written);
+            return AlignFileOffset(written);
+        };
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        size_t written = sizeof(header);
+        for (const auto& [array_data, array_size] : arrays) {
+            written = write_padding(written);
+            output.write(static_cast<const char*>(array_data), array_size);
+            written += array_size;
+        }
+        write_padding(written);
+        if (!output) {
+            return false;
+        }
+    }
+    return std::rename(temp_path.c_str(), path.c_str()) == 0;
+}
+
+template <typename Weight>
+std::unique_ptr<HubLabelIndex<Weight>> HubLabelIndex<Weight>::LoadFromFile(
+                                                    const Graph& graph,
+                                                    const std::vector<VertexId>& query_vertices,
+                                                    const std::string& path) {
+    mapped_file::MappedFile file(path);
+    if (!file.IsOpen() || file.GetSize() < sizeof(FileHeader)) {
+        return nullptr;
+    }
+    FileHeader header;
+    std::copy(file.GetData(), file.GetData() + sizeof(header), reinterpret_cast<std::byte*>(&header));
+    if (!std::equal(std::begin(FILE_MAGIC), std::end(FILE_MAGIC), header.magic)
+        || header.version != FILE_VERSION
+        || header.weight_size != sizeof(Weight)
+        || header.vertex_count != graph.GetVertexCount()
+        || header.edge_count != graph.GetEdgeCount()
+        || file.GetSize() != GetFileLayout(header.vertex_count, header.outgoing_entry_count,
+                                           header.incoming_entry_count).back()
+        || header.query_fingerprint != ComputeQueryFingerprint(query_vertices)
+        || header.graph_fingerprint != ComputeGraphFingerprint(graph)) {
+        return nullptr;
+    }
+    return std::unique_ptr<HubLabelIndex>(new HubLabelIndex(graph, std::move(file)));
+}
+
+}  // namespace graph
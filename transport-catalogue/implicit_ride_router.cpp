@@ -0,0 +1,164 @@
+#include "implicit_ride_router.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace transport_router {
+
+ImplicitRideRouter::ImplicitRideRouter(const BusLines& lines
+                                       , double bus_wait_time
+                                       , double bus_velocity)
+    : bus_wait_time_(bus_wait_time)
+    , bus_velocity_(bus_velocity)
+    , lines_(lines) {
+    stop_visits_.resize(lines.GetStopCount());
+    for (size_t line = 0; line < lines.GetLines().size(); ++line) {
+        const std::vector<size_t>& stops = lines.GetLines()[line].stops;
+        for (size_t position = 0; position < stops.size(); ++position) {
+            stop_visits_[stops[position]].push_back({line, position});
+        }
+    }
+}
+
+double ImplicitRideRouter::GetRideTime(const Ride& ride) const {
+    const BusLine& line = lines_.GetLines()[ride.line];
+    const int64_t distance = ride.from_position < ride.to_position
+        ? line.forward_distances[ride.to_position] - line.forward_distances[ride.from_position]
+        : line.backward_distances[ride.from_position] - line.backward_distances[ride.to_position];
+    return static_cast<double>(distance) / bus_velocity_;
+}
+
+ImplicitRideRouter::SearchTree ImplicitRideRouter::Search(size_t stop_from
+                                                         , const std::vector<size_t>& target_stops
+                                                         , double max_time
+                                                         , graph::SearchStats* stats) const {
+    std::vector<bool> is_pending(lines_.GetStopCount(), false);
+    size_t pending_count = 0;
+    for (const size_t stop : target_stops) {
+        if (!is_pending[stop]) {
+            is_pending[stop] = true;
+            ++pending_count;
+        }
+    }
+
+    using QueueItem = std::pair<double, size_t>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+    SearchTree tree{std::vector<std::optional<double>>(lines_.GetStopCount())
+                    , std::vector<std::optional<Ride>>(lines_.GetStopCount())};
+    tree.times[stop_from] = 0.0;
+    queue.push({0.0, stop_from});
+
+    size_t settled_stops = 0;
+    while (!queue.empty()) {
+        const auto [time, stop] = queue.top();
+        queue.pop();
+        if (time > *tree.times[stop]) {
+            continue;
+        }
+        if (time > max_time) {
+            break;
+        }
+        ++settled_stops;
+        if (is_pending[stop]) {
+            is_pending[stop] = false;
+            if (--pending_count == 0) {
+                break;
+            }
+        }
+        const double board_time = time + bus_wait_time_;
+        for (const StopVisit& visit : stop_visits_[stop]) {
+            const BusLine& line = lines_.GetLines()[visit.line];
+            // Circular routes are only ridden forward; the others in both directions.
+            const size_t first_position = line.bus->is_roundtrip ? visit.position + 1 : 0;
+            for (size_t position = first_position; position < line.stops.size(); ++position) {
+                if (position == visit.position) {
+                    continue;
+                }
+                const Ride ride{visit.line, visit.position, position, stop};
+                const double candidate = board_time + GetRideTime(ride);
+                auto& next_time = tree.times[line.stops[position]];
+                if (!next_time || candidate < *next_time) {
+                    next_time = candidate;
+                    tree.rides[line.stops[position]] = ride;
+                    queue.push({candidate, line.stops[position]});
+                }
+            }
+        }
+    }
+    if (stats) {
+        stats->settled_vertices = settled_stops;
+    }
+    return tree;
+}
+
+std::optional<std::vector<graph::Edge<double>>> ImplicitRideRouter::FindRoute(
+                                                    graph::VertexId vertex_from
+                                                    , graph::VertexId vertex_to
+                                                    , graph::SearchStats* stats) const {
+    const size_t stop_from = lines_.GetStopIndex(vertex_from);
+    const size_t stop_to = lines_.GetStopIndex(vertex_to);
+    const SearchTree tree = Search(stop_from, {stop_to}, NO_TIME_LIMIT, stats);
+    if (!tree.times[stop_to]) {
+        return std::nullopt;
+    }
+
+    std::vector<graph::Edge<double>> edges;
+    for (size_t stop = stop_to; stop != stop_from;) {
+        const Ride& ride = *tree.rides[stop];
+        const BusLine& line = lines_.GetLines()[ride.line];
+        const size_t span_count = ride.from_position < ride.to_position
+                                      ? ride.to_position - ride.from_position
+                                      : ride.from_position - ride.to_position;
+        edges.push_back({line.bus->id
+                        , static_cast<uint32_t>(span_count)
+                        , lines_.GetStopVertex(ride.from_stop) + 1
+                        , lines_.GetStopVertex(stop)
+                        , GetRideTime(ride)});
+        edges.push_back({lines_.GetStop(ride.from_stop).id
+                        , 0
+                        , lines_.GetStopVertex(ride.from_stop)
+                        , lines_.GetStopVertex(ride.from_stop) + 1
+                        , bus_wait_time_});
+        stop = ride.from_stop;
+    }
+    std::reverse(edges.begin(), edges.end());
+    return edges;
+}
+
+std::vector<std::optional<double>> ImplicitRideRouter::FindTimes(
+                                                    graph::VertexId vertex_from
+                                                    , const std::vector<graph::VertexId>& vertices_to) const {
+    if (vertices_to.empty()) {
+        return {};
+    }
+    std::vector<size_t> target_stops;
+    target_stops.reserve(vertices_to.size());
+    for (const graph::VertexId vertex_to : vertices_to) {
+        target_stops.push_back(lines_.GetStopIndex(vertex_to));
+    }
+    const SearchTree tree = Search(lines_.GetStopIndex(vertex_from), target_stops, NO_TIME_LIMIT, nullptr);
+
+    std::vector<std::optional<double>> result;
+    result.reserve(target_stops.size());
+    for (const size_t stop : target_stops) {
+        result.push_back(tree.times[stop]);
+    }
+    return result;
+}
+
+std::vector<std::pair<graph::VertexId, double>> ImplicitRideRouter::FindReachable(
+                                                    graph::VertexId vertex_from
+                                                    , double max_time) const {
+    const SearchTree tree = Search(lines_.GetStopIndex(vertex_from), {}, max_time, nullptr);
+    std::vector<std::pair<graph::VertexId, double>> result;
+    for (size_t stop = 0; stop < lines_.GetStopCount(); ++stop) {
+        if (tree.times[stop] && *tree.times[stop] <= max_time) {
+            result.push_back({lines_.GetStopVertex(stop), *tree.times[stop]});
+        }
+    }
+    return result;
+}
+
+} // namespace transport_router
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "bus_lines.h"
+#include "graph.h"
+#include "router.h"
+#include "transport_catalogue.h"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace transport_router {
+
+// Routes over bus lines without materializing a ride edge for every pair of stops.
+// Each line keeps prefix sums of road distances in both directions and the search
+// derives ride times from them on the fly, so memory and build time are linear in
+// the total length of all routes. Routes come out as the same wait and ride edges
+// TransportRouter::FillEdges would have created, with the boarding vertex of a
+// stop following its wait vertex.
+class ImplicitRideRouter {
+public:
+    // Keeps a reference to lines, which must outlive the router.
+    ImplicitRideRouter(const BusLines& lines
+                       , double bus_wait_time
+                       , double bus_velocity);
+
+    std::optional<std::vector<graph::Edge<double>>> FindRoute(
+                                                graph::VertexId vertex_from
+                                                , graph::VertexId vertex_to
+                                                , graph::SearchStats* stats = nullptr) const;
+
+    // Travel times from one stop to each of the given stops, in the same order,
+    // found by a single search.
+    std::vector<std::optional<double>> FindTimes(graph::VertexId vertex_from
+                                                 , const std::vector<graph::VertexId>& vertices_to) const;
+
+    // Wait vertices of the stops reachable within max_time, with their travel times.
+    std::vector<std::pair<graph::VertexId, double>> FindReachable(graph::VertexId vertex_from
+                                                                  , double max_time) const;
+
+private:
+    struct StopVisit {
+        size_t line;
+        size_t position;
+    };
+
+    struct Ride {
+        size_t line;
+        size_t from_position;
+        size_t to_position;
+        size_t from_stop;
+    };
+
+    struct SearchTree {
+        std::vector<std::optional<double>> times;
+        // The last ride into each reached stop.
+        std::vector<std::optional<Ride>> rides;
+    };
+
+    static constexpr double NO_TIME_LIMIT = std::numeric_limits<double>::infinity();
+
+    // Settles stops in order of travel time until every target stop is settled,
+    // if any are given, or the next stop is farther than max_time.
+    SearchTree Search(size_t stop_from
+                      , const std::vector<size_t>& target_stops
+                      , double max_time
+                      , graph::SearchStats* stats) const;
+    double GetRideTime(const Ride& ride) const;
+
+    double bus_wait_time_ = 0.0;
+    double bus_velocity_ = 0.0;
+    const BusLines& lines_;
+    std::vector<std::vector<StopVisit>> stop_visits_;
+};
+
+} // namespace transport_router
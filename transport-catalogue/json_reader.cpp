@@ -2,6 +2,7 @@
 #include "json_builder.h"
 
 #include <algorithm>
+#include <limits>
 
 using namespace std::literals;
 
@@ -55,6 +56,28 @@ void JsonReader::SetStopsDistances(transport_catalogue::TransportCatalogue& cata
     }
 }
 
+// A timetable lists its "departures" or spreads them every "interval" minutes
+// from "first_departure" to "last_departure".
+std::vector<double> ParseDepartureTimes(const json::Dict& timetable) {
+    std::vector<double> departure_times;
+    if (const auto departures = timetable.find("departures"s); departures != timetable.end()) {
+        for (const auto& departure : departures->second.AsArray()) {
+            departure_times.push_back(departure.AsDouble());
+        }
+        return departure_times;
+    }
+    const double interval = timetable.at("interval"s).AsDouble();
+    if (interval <= 0.0) {
+        throw std::invalid_argument("interval should be positive"s);
+    }
+    const double first_departure = timetable.at("first_departure"s).AsDouble();
+    const double last_departure = timetable.at("last_departure"s).AsDouble();
+    for (size_t trip = 0; first_departure + trip * interval <= last_departure; ++trip) {
+        departure_times.push_back(first_departure + trip * interval);
+    }
+    return departure_times;
+}
+
 void JsonReader::FillBuses(transport_catalogue::TransportCatalogue& catalogue) {
     const json::Array& base_requests = GetBaseRequests().AsArray();
     for (const auto& request : base_requests) {
@@ -72,10 +95,14 @@ void JsonReader::FillBuses(transport_catalogue::TransportCatalogue& catalogue) {
             for (size_t i = 0; i < stops.size(); ++i) {
                 bus_description.route_stops.push_back(stops[i].AsString());
             }
+            if (const auto timetable = request_typed.find("timetable"); timetable != request_typed.end()) {
+                bus_description.departure_times = ParseDepartureTimes(timetable->second.AsDict());
+            }
 
             catalogue.AddBus(bus_description.bus_name
                             , bus_description.route_stops
-                            , bus_description.is_roundtrip);
+                            , bus_description.is_roundtrip
+                            , std::move(bus_description.departure_times));
         }
     }
 }
@@ -96,6 +123,38 @@ json::Node ProcessErrorRequest(int request_id) {
     return result;
 }
 
+// Wait and Bus items of a route and their total time.
+// Route is anything that iterates over graph::Edge<double>: a vector of edges
+// or a RouteView that reads them in place.
+template <typename Route>
+std::pair<json::Array, double> BuildRouteItems(const Route& route, RequestHandler& rh) {
+    json::Array items_array;
+    double total_time = 0.0;
+    for (const auto& item_edge : route) {
+        if (item_edge.span_count == 0) {
+            items_array.emplace_back(json::Node(json::Builder{}
+                .StartDict()
+                    .Key("stop_name"s).Value(std::string(rh.GetStopName(item_edge.name_id)))
+                    .Key("time"s).Value(item_edge.weight)
+                    .Key("type"s).Value("Wait"s)
+                .EndDict()
+            .Build()));
+        }
+        else {
+            items_array.emplace_back(json::Node(json::Builder{}
+                .StartDict()
+                    .Key("bus"s).Value(std::string(rh.GetBusName(item_edge.name_id)))
+                    .Key("span_count"s).Value(static_cast<int>(item_edge.span_count))
+                    .Key("time"s).Value(item_edge.weight)
+                    .Key("type"s).Value("Bus"s)
+                .EndDict()
+            .Build()));
+        }
+        total_time += item_edge.weight;
+    }
+    return {std::move(items_array), total_time};
+}
+
 svg::Color JsonReader::GetColorInRightFormat(const json::Node& color_setting) const {
     svg::Color result_color;
     if (color_setting.IsString()) {
@@ -153,6 +212,62 @@ transport_router::RoutingSettings JsonReader::SetRoutingSettings(const json::Nod
     double kmph_to_mpm = 1000.0 / 60.0;
     result_settings.bus_velocity = routing_settings_dict.at("bus_velocity").AsDouble() * kmph_to_mpm;
     result_settings.bus_wait_time = routing_settings_dict.at("bus_wait_time").AsInt();
+    if (const auto thread_count = routing_settings_dict.find("thread_count");
+        thread_count != routing_settings_dict.end()) {
+        if (thread_count->second.AsInt() < 0) {
+            throw std::invalid_argument("thread_count should be non-negative"s);
+        }
+        result_settings.thread_count = static_cast<size_t>(thread_count->second.AsInt());
+    }
+    if (const auto route_cache_size = routing_settings_dict.find("route_cache_size");
+        route_cache_size != routing_settings_dict.end()) {
+        if (route_cache_size->second.AsInt() < 0) {
+            throw std::invalid_argument("route_cache_size should be non-negative"s);
+        }
+        result_settings.route_cache_size = static_cast<size_t>(route_cache_size->second.AsInt());
+    }
+    if (const auto cache_file = routing_settings_dict.find("cache_file");
+        cache_file != routing_settings_dict.end()) {
+        result_settings.cache_file = cache_file->second.AsString();
+    }
+    if (const auto hub_labels = routing_settings_dict.find("hub_labels");
+        hub_labels != routing_settings_dict.end()) {
+        result_settings.hub_labels = hub_labels->second.AsBool();
+    }
+    if (const auto hub_label_file = routing_settings_dict.find("hub_label_file");
+        hub_label_file != routing_settings_dict.end()) {
+        result_settings.hub_label_file = hub_label_file->second.AsString();
+    }
+    if (const auto weight_type = routing_settings_dict.find("weight_type");
+        weight_type != routing_settings_dict.end()) {
+        if (weight_type->second.AsString() == "float"s) {
+            result_settings.weight_type = transport_router::WeightType::FLOAT;
+        } else if (weight_type->second.AsString() == "fixed_point"s) {
+            result_settings.weight_type = transport_router::WeightType::FIXED_POINT;
+        } else if (weight_type->second.AsString() == "double"s) {
+            result_settings.weight_type = transport_router::WeightType::DOUBLE;
+        } else {
+            throw std::invalid_argument("Unknown weight_type: "s + weight_type->second.AsString());
+        }
+    }
+    if (const auto router_type = routing_settings_dict.find("router_type");
+        router_type != routing_settings_dict.end()) {
+        if (router_type->second.AsString() == "dijkstra"s) {
+            result_settings.router_type = transport_router::RouterType::DIJKSTRA;
+        } else if (router_type->second.AsString() == "astar"s) {
+            result_settings.router_type = transport_router::RouterType::A_STAR;
+        } else if (router_type->second.AsString() == "ch"s) {
+            result_settings.router_type = transport_router::RouterType::CONTRACTION_HIERARCHY;
+        } else if (router_type->second.AsString() == "stop_table"s) {
+            result_settings.router_type = transport_router::RouterType::STOP_TABLE;
+        } else if (router_type->second.AsString() == "implicit_rides"s) {
+            result_settings.router_type = transport_router::RouterType::IMPLICIT_RIDES;
+        } else if (router_type->second.AsString() == "all_pairs"s) {
+            result_settings.router_type = transport_router::RouterType::ALL_PAIRS;
+        } else {
+            throw std::invalid_argument("Unknown router_type: "s + router_type->second.AsString());
+        }
+    }
     return result_settings;
 }
 
@@ -181,9 +296,7 @@ const json::Node JsonReader::ProcessStopRequest(const json::Dict& request
         return ProcessErrorRequest(request.at("id").AsInt());
     }
 
-    const auto set_buses_at_stop = rh.GetBusesByStop(request.at("name").AsString());
-    std::vector<std::string_view> vec_buses_at_stop(set_buses_at_stop.begin()
-                                                    , set_buses_at_stop.end());
+    std::vector<std::string_view> vec_buses_at_stop = rh.GetBusesByStop(request.at("name").AsString());
     std::sort(vec_buses_at_stop.begin(), vec_buses_at_stop.end());
     json::Array buses_array;
 
@@ -216,50 +329,234 @@ const json::Node JsonReader::ProcessMapRequest(const json::Dict& map_request
 
 const json::Node JsonReader::ProcessRouteRequest(const json::Dict& request
                                                 , RequestHandler& rh) const {
+    // With a departure time the route follows the bus timetables and has no alternatives.
+    if (const auto departure_time = request.find("departure_time"s); departure_time != request.end()) {
+        if (!rh.IsStopExist(request.at("from"s).AsString())
+            || !rh.IsStopExist(request.at("to"s).AsString())) {
+            return ProcessErrorRequest(request.at("id"s).AsInt());
+        }
+        const auto route = rh.GetScheduledRoute(request.at("from"s).AsString()
+                                                , request.at("to"s).AsString()
+                                                , departure_time->second.AsDouble());
+        if (!route) {
+            return ProcessErrorRequest(request.at("id"s).AsInt());
+        }
+        const auto [items_array, total_time] = BuildRouteItems(route.value(), rh);
+        return json::Builder{}
+        .StartDict()
+            .Key("request_id"s).Value(request.at("id"s).AsInt())
+            .Key("total_time"s).Value(total_time)
+            .Key("items"s).Value(items_array)
+        .EndDict()
+        .Build();
+    }
+
+    // Without items only the total time is needed, which hub labels answer
+    // without reconstructing the route.
+    if (const auto items = request.find("items"s); items != request.end() && !items->second.AsBool()) {
+        if (!rh.IsStopExist(request.at("from"s).AsString())
+            || !rh.IsStopExist(request.at("to"s).AsString())) {
+            return ProcessErrorRequest(request.at("id"s).AsInt());
+        }
+        const auto total_time = rh.GetRouteTime(request.at("from"s).AsString()
+                                                , request.at("to"s).AsString());
+        if (!total_time) {
+            return ProcessErrorRequest(request.at("id"s).AsInt());
+        }
+        return json::Builder{}
+        .StartDict()
+            .Key("request_id"s).Value(request.at("id"s).AsInt())
+            .Key("total_time"s).Value(*total_time)
+        .EndDict()
+        .Build();
+    }
+
     const auto route = rh.GetOptimalRoute(request.at("from").AsString()
                                             , request.at("to").AsString());
     if (!route) {
         return ProcessErrorRequest(request.at("id").AsInt());
     }
 
-    json::Array items_array;
-    double total_time = 0.0;
-    for (const auto& item_edge : route.value()) {
-            if (item_edge.span_count == 0) {
-                items_array.emplace_back(json::Node(json::Builder{}
-                    .StartDict()
-                        .Key("stop_name"s).Value(item_edge.name)
-                        .Key("time"s).Value(item_edge.weight)
-                        .Key("type"s).Value("Wait"s)
-                    .EndDict()
-                .Build()));
-
-                total_time += item_edge.weight;
+    const auto [items_array, total_time] = BuildRouteItems(route.value(), rh);
+    json::Node result = json::Builder{}
+    .StartDict()
+        .Key("request_id"s).Value(request.at("id"s).AsInt())
+        .Key("total_time"s).Value(total_time)
+        .Key("items"s).Value(items_array)
+    .EndDict()
+    .Build();
+
+    const auto max_alternatives = request.find("max_alternatives"s);
+    if (max_alternatives == request.end() || max_alternatives->second.AsInt() <= 0) {
+        return result;
+    }
+    // The best route is already the answer itself; ties may make the search
+    // find it or another one on the same buses first, so the route on its
+    // buses is skipped rather than assumed to come first.
+    const auto get_buses = [](const auto& edges) {
+        std::vector<uint32_t> buses;
+        for (const auto& edge : edges) {
+            if (edge.span_count > 0) {
+                buses.push_back(edge.name_id);
             }
-            else {
-                items_array.emplace_back(json::Node(json::Builder{}
-                    .StartDict()
-                        .Key("bus"s).Value(item_edge.name)
-                        .Key("span_count"s).Value(static_cast<int>(item_edge.span_count))
-                        .Key("time"s).Value(item_edge.weight)
-                        .Key("type"s).Value("Bus"s)
-                    .EndDict()
-                .Build()));
-
-                total_time += item_edge.weight;
+        }
+        return buses;
+    };
+    const std::vector<uint32_t> route_buses = get_buses(*route);
+    const auto is_same_route = [&](const std::vector<graph::Edge<double>>& other) {
+        return get_buses(other) == route_buses;
+    };
+    const size_t alternative_count = static_cast<size_t>(max_alternatives->second.AsInt());
+    json::Array alternatives_array;
+    for (const auto& alternative : rh.GetAlternativeRoutes(request.at("from"s).AsString()
+                                                          , request.at("to"s).AsString()
+                                                          , alternative_count + 1)) {
+        if (alternatives_array.size() == alternative_count || is_same_route(alternative)) {
+            continue;
+        }
+        const auto [alternative_items, alternative_time] = BuildRouteItems(alternative, rh);
+        alternatives_array.emplace_back(json::Node(json::Builder{}
+            .StartDict()
+                .Key("total_time"s).Value(alternative_time)
+                .Key("items"s).Value(alternative_items)
+            .EndDict()
+        .Build()));
+    }
+    json::Dict result_dict = result.AsDict();
+    result_dict.emplace("alternatives"s, std::move(alternatives_array));
+    return json::Node(std::move(result_dict));
+}
+
+const json::Node JsonReader::ProcessParetoRouteRequest(const json::Dict& request
+                                                , RequestHandler& rh) const {
+    if (!rh.IsStopExist(request.at("from"s).AsString())
+        || !rh.IsStopExist(request.at("to"s).AsString())) {
+        return ProcessErrorRequest(request.at("id"s).AsInt());
+    }
+    std::optional<size_t> max_transfers;
+    if (const auto max_transfers_node = request.find("max_transfers"s);
+        max_transfers_node != request.end()) {
+        if (max_transfers_node->second.AsInt() < 0) {
+            throw std::invalid_argument("max_transfers should be non-negative"s);
+        }
+        max_transfers = static_cast<size_t>(max_transfers_node->second.AsInt());
+    }
+    const auto routes = rh.GetParetoRoutes(request.at("from"s).AsString()
+                                           , request.at("to"s).AsString()
+                                           , max_transfers);
+    if (routes.empty()) {
+        return ProcessErrorRequest(request.at("id"s).AsInt());
+    }
+
+    json::Array routes_array;
+    for (const auto& route : routes) {
+        const auto [items_array, total_time] = BuildRouteItems(route, rh);
+        const auto ride_count = std::count_if(route.begin(), route.end(), [](const auto& edge) {
+            return edge.span_count > 0;
+        });
+        routes_array.emplace_back(json::Node(json::Builder{}
+            .StartDict()
+                .Key("total_time"s).Value(total_time)
+                .Key("transfer_count"s).Value(static_cast<int>(ride_count > 0 ? ride_count - 1 : 0))
+                .Key("items"s).Value(items_array)
+            .EndDict()
+        .Build()));
+    }
+    json::Node result = json::Builder{}
+    .StartDict()
+        .Key("request_id"s).Value(request.at("id"s).AsInt())
+        .Key("routes"s).Value(routes_array)
+    .EndDict()
+    .Build();
+
+    return result;
+}
+
+const json::Node JsonReader::ProcessRouteMatrixRequest(const json::Dict& request
+                                                , RequestHandler& rh) const {
+    const auto get_stops = [&rh](const json::Array& stop_names) {
+        std::optional<std::vector<std::string_view>> stops = std::vector<std::string_view>{};
+        stops->reserve(stop_names.size());
+        for (const auto& stop_name : stop_names) {
+            if (!rh.IsStopExist(stop_name.AsString())) {
+                return std::optional<std::vector<std::string_view>>{};
             }
+            stops->push_back(stop_name.AsString());
+        }
+        return stops;
+    };
+    const auto stops_from = get_stops(request.at("from"s).AsArray());
+    const auto stops_to = get_stops(request.at("to"s).AsArray());
+    if (!stops_from || !stops_to) {
+        return ProcessErrorRequest(request.at("id"s).AsInt());
+    }
+
+    // One array of times per origin; null marks destinations without a route.
+    json::Array times_array;
+    times_array.reserve(stops_from->size());
+    for (const auto& row : rh.GetRouteTimeMatrix(*stops_from, *stops_to)) {
+        json::Array row_array;
+        row_array.reserve(row.size());
+        for (const auto& time : row) {
+            row_array.emplace_back(time ? json::Node(*time) : json::Node(nullptr));
+        }
+        times_array.emplace_back(std::move(row_array));
     }
     json::Node result = json::Builder{}
     .StartDict()
         .Key("request_id"s).Value(request.at("id"s).AsInt())
-        .Key("total_time"s).Value(total_time)
-        .Key("items"s).Value(items_array)
+        .Key("times"s).Value(times_array)
     .EndDict()
     .Build();
 
     return result;
 }
 
+const json::Node JsonReader::ProcessReachableRequest(const json::Dict& request
+                                                , RequestHandler& rh) const {
+    if (!rh.IsStopExist(request.at("from"s).AsString())) {
+        return ProcessErrorRequest(request.at("id"s).AsInt());
+    }
+
+    json::Array stops_array;
+    for (const auto& [stop_name, time] : rh.GetReachableStops(request.at("from"s).AsString()
+                                                              , request.at("max_time"s).AsDouble())) {
+        stops_array.emplace_back(json::Node(json::Builder{}
+            .StartDict()
+                .Key("stop_name"s).Value(std::string(stop_name))
+                .Key("time"s).Value(time)
+            .EndDict()
+        .Build()));
+    }
+    json::Node result = json::Builder{}
+    .StartDict()
+        .Key("request_id"s).Value(request.at("id"s).AsInt())
+        .Key("stops"s).Value(stops_array)
+    .EndDict()
+    .Build();
+
+    return result;
+}
+
+const json::Node JsonReader::ProcessRouteCacheStatsRequest(const json::Dict& request
+                                                      , RequestHandler& rh) const {
+    const lru_cache::CacheStats stats = rh.GetRouteCacheStats();
+    // Counters past the int range go out as doubles rather than wrapping around.
+    const auto get_count_value = [](size_t count) -> json::Node::Value {
+        if (count > static_cast<size_t>(std::numeric_limits<int>::max())) {
+            return static_cast<double>(count);
+        }
+        return static_cast<int>(count);
+    };
+    return json::Builder{}
+    .StartDict()
+        .Key("request_id"s).Value(request.at("id"s).AsInt())
+        .Key("hits"s).Value(get_count_value(stats.hits))
+        .Key("misses"s).Value(get_count_value(stats.misses))
+    .EndDict()
+    .Build();
+}
+
 void JsonReader::ProcessRequests(const json::Node& stat_requests
                                     , RequestHandler& rh) const {
     json::Array result;                                
@@ -280,6 +577,18 @@ void JsonReader::ProcessRequests(const json::Node& stat_requests
             if (request_typed.at("type").AsString() == "Route") {
                 result.emplace_back(ProcessRouteRequest(request_typed, rh));
             }
+            if (request_typed.at("type").AsString() == "ParetoRoute") {
+                result.emplace_back(ProcessParetoRouteRequest(request_typed, rh));
+            }
+            if (request_typed.at("type").AsString() == "RouteMatrix") {
+                result.emplace_back(ProcessRouteMatrixRequest(request_typed, rh));
+            }
+            if (request_typed.at("type").AsString() == "Reachable") {
+                result.emplace_back(ProcessReachableRequest(request_typed, rh));
+            }
+            if (request_typed.at("type").AsString() == "RouteCacheStats") {
+                result.emplace_back(ProcessRouteCacheStatsRequest(request_typed, rh));
+            }
         }
     }
 
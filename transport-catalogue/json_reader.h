@@ -20,6 +20,7 @@ struct BusDescription {
     std::string bus_name;
     std::vector<std::string_view> route_stops;
     bool is_roundtrip = false;
+    std::vector<double> departure_times;
 };
 
 class JsonReader {
@@ -47,6 +48,10 @@ public:
     const json::Node ProcessStopRequest(const json::Dict& request, RequestHandler& rh) const;
     const json::Node ProcessMapRequest(const json::Dict& request, RequestHandler& rh) const;
     const json::Node ProcessRouteRequest(const json::Dict& request, RequestHandler& rh) const;   
+    const json::Node ProcessParetoRouteRequest(const json::Dict& request, RequestHandler& rh) const;
+    const json::Node ProcessRouteMatrixRequest(const json::Dict& request, RequestHandler& rh) const;
+    const json::Node ProcessReachableRequest(const json::Dict& request, RequestHandler& rh) const;
+    const json::Node ProcessRouteCacheStatsRequest(const json::Dict& request, RequestHandler& rh) const;
     void ProcessRequests(const json::Node& stat_requests, RequestHandler& rh) const;
 
 private:
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace lru_cache {
+
+struct CacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+// Bounded least-recently-used cache split into independently locked shards by
+// key hash, so concurrent lookups of different keys rarely wait for each other.
+// Each shard evicts on its own once it holds its share of the capacity; the
+// shares add up to the capacity exactly, with fewer shards below SHARD_COUNT.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedLruCache {
+public:
+    explicit ShardedLruCache(size_t capacity);
+
+    ShardedLruCache(const ShardedLruCache&) = delete;
+    ShardedLruCache& operator=(const ShardedLruCache&) = delete;
+
+    // Returns a copy of the cached value and marks it as the most recently used.
+    std::optional<Value> Get(const Key& key);
+    void Put(const Key& key, Value value);
+
+    CacheStats GetStats() const;
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    using Entry = std::pair<Key, Value>;
+
+    struct Shard {
+        std::mutex mutex;
+        size_t capacity = 0;
+        // Most recently used first.
+        std::list<Entry> entries;
+        std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> positions;
+    };
+
+    Shard& GetShard(const Key& key);
+
+    Hash hash_;
+    // Shards in use, at least one.
+    size_t shard_count_;
+    std::array<Shard, SHARD_COUNT> shards_;
+    std::atomic<size_t> hits_ = 0;
+    std::atomic<size_t> misses_ = 0;
+};
+
+template <typename Key, typename Value, typename Hash>
+ShardedLruCache<Key, Value, Hash>::ShardedLruCache(size_t capacity)
+    : shard_count_(std::clamp<size_t>(capacity, 1, SHARD_COUNT)) {
+    for (size_t shard = 0; shard < shard_count_; ++shard) {
+        shards_[shard].capacity = capacity / shard_count_ + (shard < capacity % shard_count_ ? 1 : 0);
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+typename ShardedLruCache<Key, Value, Hash>::Shard&
+ShardedLruCache<Key, Value, Hash>::GetShard(const Key& key) {
+    // The low bits also pick the bucket inside the shard, so mix in the high ones.
+    const size_t hash = hash_(key);
+    return shards_[(hash ^ (hash >> (sizeof(size_t) * 4))) % shard_count_];
+}
+
+template <typename Key, typename Value, typename Hash>
+std::optional<Value> ShardedLruCache<Key, Value, Hash>::Get(const Key& key) {
+    Shard& shard = GetShard(key);
+    std::lock_guard lock(shard.mutex);
+    const auto position = shard.positions.find(key);
+    if (position == shard.positions.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    shard.entries.splice(shard.entries.begin(), shard.entries, position->second);
+    return position->second->second;
+}
+
+template <typename Key, typename Value, typename Hash>
+void ShardedLruCache<Key, Value, Hash>::Put(const Key& key, Value value) {
+    Shard& shard = GetShard(key);
+    if (shard.capacity == 0) {
+        return;
+    }
+    std::lock_guard lock(shard.mutex);
+    if (const auto position = shard.positions.find(key); position != shard.positions.end()) {
+        position->second->second = std::move(value);
+        shard.entries.splice(shard.entries.begin(), shard.entries, position->second);
+        return;
+    }
+    if (shard.entries.size() == shard.capacity) {
+        shard.positions.erase(shard.entries.back().first);
+        shard.entries.pop_back();
+    }
+    shard.entries.emplace_front(key, std::move(value));
+    shard.positions.emplace(key, shard.entries.begin());
+}
+
+template <typename Key, typename Value, typename Hash>
+CacheStats ShardedLruCache<Key, Value, Hash>::GetStats() const {
+    return {hits_.load(std::memory_order_relaxed), misses_.load(std::memory_order_relaxed)};
+}
+
+} // namespace lru_cache
@@ -10,6 +10,7 @@ int main() {
     TransportCatalogue catalogue;
     json_reader::JsonReader json_doc(cin);
     json_doc.FillTransportCatalogue(catalogue);
+    catalogue.Freeze();
     const auto& rend_settings = json_doc.GetRenderSettings();
     const auto& map_renderer = json_doc.SetRenderSettings(rend_settings);
     const auto& routing_settings = json_doc.SetRoutingSettings(json_doc.GetRoutingSettings());
@@ -8,10 +8,12 @@ bool IsZero(double value) {
 
 std::vector<std::pair<std::string_view
 , const transport_catalogue::Bus*>> MapRenderer::GetSortedAllBuses(
-                                        const std::unordered_map<std::string_view
-                                        , const transport_catalogue::Bus*>& all_buses) const {
-    std::vector<std::pair<std::string_view, const transport_catalogue::Bus*>> result(
-                                                            all_buses.begin(), all_buses.end());
+                                        const std::vector<const transport_catalogue::Bus*>& all_buses) const {
+    std::vector<std::pair<std::string_view, const transport_catalogue::Bus*>> result;
+    result.reserve(all_buses.size());
+    for (const transport_catalogue::Bus* bus : all_buses) {
+        result.push_back({bus->name, bus});
+    }
     std::sort(result.begin(), result.end());
     return result;
 }
@@ -64,7 +66,7 @@ std::vector<svg::Text> MapRenderer::CreateSvgBusLabels(
                     static_cast<uint32_t>(render_settings_.bus_label_font_size));
         bus_label.SetFontFamily("Verdana");
         bus_label.SetFontWeight("bold");
-        bus_label.SetData(bus->name);
+        bus_label.SetData(std::string(bus->name));
         bus_label.SetFillColor(render_settings_.color_palette[color_num]);
         
         color_num < (render_settings_.color_palette.size() - 1) ? ++color_num : color_num = 0;
@@ -75,7 +77,7 @@ std::vector<svg::Text> MapRenderer::CreateSvgBusLabels(
                     static_cast<uint32_t>(render_settings_.bus_label_font_size));
         bus_underlayer.SetFontFamily("Verdana");
         bus_underlayer.SetFontWeight("bold");
-        bus_underlayer.SetData(bus->name);
+        bus_underlayer.SetData(std::string(bus->name));
         bus_underlayer.SetFillColor(render_settings_.underlayer_color);
         bus_underlayer.SetStrokeColor(render_settings_.underlayer_color);
         bus_underlayer.SetStrokeWidth(render_settings_.underlayer_width);
@@ -132,7 +134,7 @@ std::vector<svg::Text> MapRenderer::CreateSvgBusLabels(
             stop_label.SetFontSize(
                     static_cast<uint32_t>(render_settings_.stop_label_font_size));
             stop_label.SetFontFamily("Verdana");
-            stop_label.SetData(stop->name);
+            stop_label.SetData(std::string(stop->name));
             stop_label.SetFillColor("black");
     
             stop_underlayer.SetPosition(sp(stop->coordinates));
@@ -140,7 +142,7 @@ std::vector<svg::Text> MapRenderer::CreateSvgBusLabels(
             stop_underlayer.SetFontSize(
                     static_cast<uint32_t>(render_settings_.stop_label_font_size));
             stop_underlayer.SetFontFamily("Verdana");
-            stop_underlayer.SetData(stop->name);
+            stop_underlayer.SetData(std::string(stop->name));
             stop_underlayer.SetFillColor(render_settings_.underlayer_color);
             stop_underlayer.SetStrokeColor(render_settings_.underlayer_color);
             stop_underlayer.SetStrokeWidth(render_settings_.underlayer_width);
@@ -154,8 +156,8 @@ std::vector<svg::Text> MapRenderer::CreateSvgBusLabels(
         return result;
     }
 
-svg::Document MapRenderer::CreateSvgDoc(const std::unordered_map<std::string_view
-    , const transport_catalogue::Bus*>& all_buses) const {
+svg::Document MapRenderer::CreateSvgDoc(
+    const std::vector<const transport_catalogue::Bus*>& all_buses) const {
         svg::Document result;
         std::vector<geo::Coordinates> route_stops_coord;
         std::vector<std::pair<std::string_view
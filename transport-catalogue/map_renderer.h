@@ -7,7 +7,6 @@
 #include <algorithm>
 #include <map>
 #include <vector>
-#include <unordered_map>
 
 namespace map_renderer {
 
@@ -111,8 +110,8 @@ public:
                                 std::map<std::string_view
                                 , const transport_catalogue::Stop*>& all_routes_stops
                                 , const SphereProjector& sp) const;
-    svg::Document CreateSvgDoc(const std::unordered_map<std::string_view
-                                , const transport_catalogue::Bus*>& all_buses) const;
+    svg::Document CreateSvgDoc(
+                                const std::vector<const transport_catalogue::Bus*>& all_buses) const;
 
     void PrintMap(svg::Document& rendered_map, std::ostream& output) const;
 
@@ -121,8 +120,7 @@ private:
 
     std::vector<std::pair<std::string_view
                 , const transport_catalogue::Bus*>> GetSortedAllBuses(
-                                    const std::unordered_map<std::string_view
-                                    , const transport_catalogue::Bus*>& all_buses) const;
+                                    const std::vector<const transport_catalogue::Bus*>& all_buses) const;
 };
 
 } // namespace map_renderer
\ No newline at end of file
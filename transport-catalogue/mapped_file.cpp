@@ -0,0 +1,90 @@
+#include "mapped_file.h"
+
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mapped_file {
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef MAPPED_FILE_POSIX
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat file_stat {};
+    if (::fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+        void* data = ::mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ
+                            , MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            data_ = static_cast<const std::byte*>(data);
+            size_ = static_cast<size_t>(file_stat.st_size);
+            is_mapped_ = true;
+        }
+    }
+    ::close(fd);
+#else
+    std::ifstream input(path, std::ios::binary | std::ios::ate);
+    if (!input) {
+        return;
+    }
+    buffer_.resize(static_cast<size_t>(input.tellg()));
+    input.seekg(0);
+    if (input.read(reinterpret_cast<char*>(buffer_.data()), buffer_.size())) {
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+#endif
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        is_mapped_ = std::exchange(other.is_mapped_, false);
+        buffer_ = std::move(other.buffer_);
+    }
+    return *this;
+}
+
+bool MappedFile::IsOpen() const {
+    return data_ != nullptr;
+}
+
+const std::byte* MappedFile::GetData() const {
+    return data_;
+}
+
+size_t MappedFile::GetSize() const {
+    return size_;
+}
+
+void MappedFile::Close() {
+#ifdef MAPPED_FILE_POSIX
+    if (is_mapped_) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    is_mapped_ = false;
+    buffer_.clear();
+}
+
+} // namespace mapped_file
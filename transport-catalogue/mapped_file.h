@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace mapped_file {
+
+// Read-only view of a whole file. Uses mmap where available and falls back to
+// reading the file into memory elsewhere.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool IsOpen() const;
+    const std::byte* GetData() const;
+    size_t GetSize() const;
+
+private:
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+    bool is_mapped_ = false;
+    std::vector<std::byte> buffer_;
+
+    void Close();
+};
+
+} // namespace mapped_file
@@ -0,0 +1,324 @@
+#include "min_plus_kernel.h"
+
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MIN_PLUS_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+namespace graph {
+
+namespace detail {
+
+namespace {
+
+template <typename Weight>
+void RelaxRowScalar(Weight weight_from, PackedEdgeId prev_edge_from,
+                    const Weight* through_weights, const PackedEdgeId* through_prev_edges,
+                    Weight* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        // Integer weights mark missing routes with their maximum, which must not wrap around.
+        if constexpr (std::is_integral_v<Weight>) {
+            if (through_weights[i] > std::numeric_limits<Weight>::max() - weight_from) {
+                continue;
+            }
+        }
+        const Weight candidate_weight = weight_from + through_weights[i];
+        if (candidate_weight < row_weights[i]) {
+            row_weights[i] = candidate_weight;
+            row_prev_edges[i] = through_prev_edges[i] != NO_EDGE ? through_prev_edges[i]
+                                                                 : prev_edge_from;
+        }
+    }
+}
+
+#ifdef MIN_PLUS_KERNEL_X86
+
+__attribute__((target("sse4.1")))
+void RelaxRowSse4(double weight_from, PackedEdgeId prev_edge_from,
+                  const double* through_weights, const PackedEdgeId* through_prev_edges,
+                  double* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    const __m128d weight_from_vec = _mm_set1_pd(weight_from);
+    const __m128i prev_edge_from_vec = _mm_set1_epi32(static_cast<int>(prev_edge_from));
+    const __m128i no_edge_vec = _mm_set1_epi32(static_cast<int>(NO_EDGE));
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128d candidate = _mm_add_pd(weight_from_vec, _mm_loadu_pd(through_weights + i));
+        const __m128d current = _mm_loadu_pd(row_weights + i);
+        const __m128d improved = _mm_cmplt_pd(candidate, current);
+        if (_mm_movemask_pd(improved) == 0) {
+            continue;
+        }
+        _mm_storeu_pd(row_weights + i, _mm_blendv_pd(current, candidate, improved));
+
+        const __m128i through_prev = _mm_loadl_epi64(
+            reinterpret_cast<const __m128i*>(through_prev_edges + i));
+        const __m128i prev_candidate = _mm_blendv_epi8(
+            through_prev, prev_edge_from_vec, _mm_cmpeq_epi32(through_prev, no_edge_vec));
+        const __m128i improved_32 = _mm_shuffle_epi32(_mm_castpd_si128(improved),
+                                                      _MM_SHUFFLE(2, 0, 2, 0));
+        __m128i* const row_prev = reinterpret_cast<__m128i*>(row_prev_edges + i);
+        _mm_storel_epi64(row_prev,
+                         _mm_blendv_epi8(_mm_loadl_epi64(row_prev), prev_candidate, improved_32));
+    }
+    RelaxRowScalar(weight_from, prev_edge_from, through_weights + i, through_prev_edges + i,
+                   row_weights + i, row_prev_edges + i, count - i);
+}
+
+__attribute__((target("avx2")))
+void RelaxRowAvx2(double weight_from, PackedEdgeId prev_edge_from,
+                  const double* through_weights, const PackedEdgeId* through_prev_edges,
+                  double* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    const __m256d weight_from_vec = _mm256_set1_pd(weight_from);
+    const __m128i prev_edge_from_vec = _mm_set1_epi32(static_cast<int>(prev_edge_from));
+    const __m128i no_edge_vec = _mm_set1_epi32(static_cast<int>(NO_EDGE));
+    const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d candidate = _mm256_add_pd(weight_from_vec,
+                                                _mm256_loadu_pd(through_weights + i));
+        const __m256d current = _mm256_loadu_pd(row_weights + i);
+        const __m256d improved = _mm256_cmp_pd(candidate, current, _CMP_LT_OQ);
+        if (_mm256_movemask_pd(improved) == 0) {
+            continue;
+        }
+        _mm256_storeu_pd(row_weights + i, _mm256_blendv_pd(current, candidate, improved));
+
+        const __m128i through_prev = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(through_prev_edges + i));
+        const __m128i prev_candidate = _mm_blendv_epi8(
+            through_prev, prev_edge_from_vec, _mm_cmpeq_epi32(through_prev, no_edge_vec));
+        const __m128i improved_32 = _mm256_castsi256_si128(
+            _mm256_permutevar8x32_epi32(_mm256_castpd_si256(improved), low_halves));
+        __m128i* const row_prev = reinterpret_cast<__m128i*>(row_prev_edges + i);
+        _mm_storeu_si128(row_prev,
+                         _mm_blendv_epi8(_mm_loadu_si128(row_prev), prev_candidate, improved_32));
+    }
+    RelaxRowScalar(weight_from, prev_edge_from, through_weights + i, through_prev_edges + i,
+                   row_weights + i, row_prev_edges + i, count - i);
+}
+
+// Single precision and fixed-point weights are as wide as the edge ids, so one
+// comparison mask selects both and a register holds twice the lanes of double.
+
+__attribute__((target("sse4.1")))
+void RelaxRowSse4(float weight_from, PackedEdgeId prev_edge_from,
+                  const float* through_weights, const PackedEdgeId* through_prev_edges,
+                  float* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    const __m128 weight_from_vec = _mm_set1_ps(weight_from);
+    const __m128i prev_edge_from_vec = _mm_set1_epi32(static_cast<int>(prev_edge_from));
+    const __m128i no_edge_vec = _mm_set1_epi32(static_cast<int>(NO_EDGE));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 candidate = _mm_add_ps(weight_from_vec, _mm_loadu_ps(through_weights + i));
+        const __m128 current = _mm_loadu_ps(row_weights + i);
+        const __m128 improved = _mm_cmplt_ps(candidate, current);
+        if (_mm_movemask_ps(improved) == 0) {
+            continue;
+        }
+        _mm_storeu_ps(row_weights + i, _mm_blendv_ps(current, candidate, improved));
+
+        const __m128i through_prev = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(through_prev_edges + i));
+        const __m128i prev_candidate = _mm_blendv_epi8(
+            through_prev, prev_edge_from_vec, _mm_cmpeq_epi32(through_prev, no_edge_vec));
+        __m128i* const row_prev = reinterpret_cast<__m128i*>(row_prev_edges + i);
+        _mm_storeu_si128(row_prev, _mm_blendv_epi8(_mm_loadu_si128(row_prev), prev_candidate,
+                                                   _mm_castps_si128(improved)));
+    }
+    RelaxRowScalar(weight_from, prev_edge_from, through_weights + i, through_prev_edges + i,
+                   row_weights + i, row_prev_edges + i, count - i);
+}
+
+__attribute__((target("avx2")))
+void RelaxRowAvx2(float weight_from, PackedEdgeId prev_edge_from,
+                  const float* through_weights, const PackedEdgeId* through_prev_edges,
+                  float* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    const __m256 weight_from_vec = _mm256_set1_ps(weight_from);
+    const __m256i prev_edge_from_vec = _mm256_set1_epi32(static_cast<int>(prev_edge_from));
+    const __m256i no_edge_vec = _mm256_set1_epi32(static_cast<int>(NO_EDGE));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 candidate = _mm256_add_ps(weight_from_vec, _mm256_loadu_ps(through_weights + i));
+        const __m256 current = _mm256_loadu_ps(row_weights + i);
+        const __m256 improved = _mm256_cmp_ps(candidate, current, _CMP_LT_OQ);
+        if (_mm256_movemask_ps(improved) == 0) {
+            continue;
+        }
+        _mm256_storeu_ps(row_weights + i, _mm256_blendv_ps(current, candidate, improved));
+
+        const __m256i through_prev = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(through_prev_edges + i));
+        const __m256i prev_candidate = _mm256_blendv_epi8(
+            through_prev, prev_edge_from_vec, _mm256_cmpeq_epi32(through_prev, no_edge_vec));
+        __m256i* const row_prev = reinterpret_cast<__m256i*>(row_prev_edges + i);
+        _mm256_storeu_si256(row_prev, _mm256_blendv_epi8(_mm256_loadu_si256(row_prev), prev_candidate,
+                                                         _mm256_castps_si256(improved)));
+    }
+    RelaxRowScalar(weight_from, prev_edge_from, through_weights + i, through_prev_edges + i,
+                   row_weights + i, row_prev_edges + i, count - i);
+}
+
+// Unsigned lanes have no ordered comparison, so a < b is min(a, b) == a and a != b,
+// and a sum that wrapped around is smaller than the addend.
+__attribute__((target("sse4.1")))
+void RelaxRowSse4(uint32_t weight_from, PackedEdgeId prev_edge_from,
+                  const uint32_t* through_weights, const PackedEdgeId* through_prev_edges,
+                  uint32_t* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    const __m128i weight_from_vec = _mm_set1_epi32(static_cast<int>(weight_from));
+    const __m128i prev_edge_from_vec = _mm_set1_epi32(static_cast<int>(prev_edge_from));
+    const __m128i no_edge_vec = _mm_set1_epi32(static_cast<int>(NO_EDGE));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i through = _mm_loadu_si128(reinterpret_cast<const __m128i*>(through_weights + i));
+        const __m128i candidate = _mm_add_epi32(weight_from_vec, through);
+        __m128i* const row = reinterpret_cast<__m128i*>(row_weights + i);
+        const __m128i current = _mm_loadu_si128(row);
+        const __m128i not_wrapped = _mm_cmpeq_epi32(_mm_max_epu32(candidate, through), candidate);
+        const __m128i not_greater = _mm_cmpeq_epi32(_mm_min_epu32(candidate, current), candidate);
+        const __m128i improved = _mm_andnot_si128(_mm_cmpeq_epi32(candidate, current),
+                                                  _mm_and_si128(not_wrapped, not_greater));
+        if (_mm_movemask_epi8(improved) == 0) {
+            continue;
+        }
+        _mm_storeu_si128(row, _mm_blendv_epi8(current, candidate, improved));
+
+        const __m128i through_prev = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(through_prev_edges + i));
+        const __m128i prev_candidate = _mm_blendv_epi8(
+            through_prev, prev_edge_from_vec, _mm_cmpeq_epi32(through_prev, no_edge_vec));
+        __m128i* const row_prev = reinterpret_cast<__m128i*>(row_prev_edges + i);
+        _mm_storeu_si128(row_prev, _mm_blendv_epi8(_mm_loadu_si128(row_prev), prev_candidate, improved));
+    }
+    RelaxRowScalar(weight_from, prev_edge_from, through_weights + i, through_prev_edges + i,
+                   row_weights + i, row_prev_edges + i, count - i);
+}
+
+__attribute__((target("avx2")))
+void RelaxRowAvx2(uint32_t weight_from, PackedEdgeId prev_edge_from,
+                  const uint32_t* through_weights, const PackedEdgeId* through_prev_edges,
+                  uint32_t* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    const __m256i weight_from_vec = _mm256_set1_epi32(static_cast<int>(weight_from));
+    const __m256i prev_edge_from_vec = _mm256_set1_epi32(static_cast<int>(prev_edge_from));
+    const __m256i no_edge_vec = _mm256_set1_epi32(static_cast<int>(NO_EDGE));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i through = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(through_weights + i));
+        const __m256i candidate = _mm256_add_epi32(weight_from_vec, through);
+        __m256i* const row = reinterpret_cast<__m256i*>(row_weights + i);
+        const __m256i current = _mm256_loadu_si256(row);
+        const __m256i not_wrapped = _mm256_cmpeq_epi32(_mm256_max_epu32(candidate, through), candidate);
+        const __m256i not_greater = _mm256_cmpeq_epi32(_mm256_min_epu32(candidate, current), candidate);
+        const __m256i improved = _mm256_andnot_si256(_mm256_cmpeq_epi32(candidate, current),
+                                                     _mm256_and_si256(not_wrapped, not_greater));
+        if (_mm256_movemask_epi8(improved) == 0) {
+            continue;
+        }
+        _mm256_storeu_si256(row, _mm256_blendv_epi8(current, candidate, improved));
+
+        const __m256i through_prev = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(through_prev_edges + i));
+        const __m256i prev_candidate = _mm256_blendv_epi8(
+            through_prev, prev_edge_from_vec, _mm256_cmpeq_epi32(through_prev, no_edge_vec));
+        __m256i* const row_prev = reinterpret_cast<__m256i*>(row_prev_edges + i);
+        _mm256_storeu_si256(row_prev, _mm256_blendv_epi8(_mm256_loadu_si256(row_prev), prev_candidate,
+                                                         improved));
+    }
+    RelaxRowScalar(weight_from, prev_edge_from, through_weights + i, through_prev_edges + i,
+                   row_weights + i, row_prev_edges + i, count - i);
+}
+
+#endif // MIN_PLUS_KERNEL_X86
+
+MinPlusKernel DetectMinPlusKernel() {
+#ifdef MIN_PLUS_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return MinPlusKernel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return MinPlusKernel::SSE4;
+    }
+#endif
+    return MinPlusKernel::SCALAR;
+}
+
+} // namespace
+
+MinPlusKernel GetMinPlusKernel() {
+    static const MinPlusKernel kernel = DetectMinPlusKernel();
+    return kernel;
+}
+
+namespace {
+
+template <typename Weight>
+void RelaxRowWithKernel(MinPlusKernel kernel, Weight weight_from, PackedEdgeId prev_edge_from,
+                        const Weight* through_weights, const PackedEdgeId* through_prev_edges,
+                        Weight* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    switch (kernel) {
+#ifdef MIN_PLUS_KERNEL_X86
+    case MinPlusKernel::AVX2:
+        RelaxRowAvx2(weight_from, prev_edge_from, through_weights, through_prev_edges,
+                     row_weights, row_prev_edges, count);
+        return;
+    case MinPlusKernel::SSE4:
+        RelaxRowSse4(weight_from, prev_edge_from, through_weights, through_prev_edges,
+                     row_weights, row_prev_edges, count);
+        return;
+#endif
+    default:
+        RelaxRowScalar(weight_from, prev_edge_from, through_weights, through_prev_edges,
+                       row_weights, row_prev_edges, count);
+        return;
+    }
+}
+
+} // namespace
+
+void RelaxRowMinPlus(double weight_from, PackedEdgeId prev_edge_from,
+                     const double* through_weights, const PackedEdgeId* through_prev_edges,
+                     double* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    RelaxRowWithKernel(GetMinPlusKernel(), weight_from, prev_edge_from, through_weights,
+                       through_prev_edges, row_weights, row_prev_edges, count);
+}
+
+void RelaxRowMinPlus(MinPlusKernel kernel, double weight_from, PackedEdgeId prev_edge_from,
+                     const double* through_weights, const PackedEdgeId* through_prev_edges,
+                     double* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    RelaxRowWithKernel(kernel, weight_from, prev_edge_from, through_weights,
+                       through_prev_edges, row_weights, row_prev_edges, count);
+}
+
+void RelaxRowMinPlus(float weight_from, PackedEdgeId prev_edge_from,
+                     const float* through_weights, const PackedEdgeId* through_prev_edges,
+                     float* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    RelaxRowWithKernel(GetMinPlusKernel(), weight_from, prev_edge_from, through_weights,
+                       through_prev_edges, row_weights, row_prev_edges, count);
+}
+
+void RelaxRowMinPlus(MinPlusKernel kernel, float weight_from, PackedEdgeId prev_edge_from,
+                     const float* through_weights, const PackedEdgeId* through_prev_edges,
+                     float* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    RelaxRowWithKernel(kernel, weight_from, prev_edge_from, through_weights,
+                       through_prev_edges, row_weights, row_prev_edges, count);
+}
+
+void RelaxRowMinPlus(uint32_t weight_from, PackedEdgeId prev_edge_from,
+                     const uint32_t* through_weights, const PackedEdgeId* through_prev_edges,
+                     uint32_t* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    RelaxRowWithKernel(GetMinPlusKernel(), weight_from, prev_edge_from, through_weights,
+                       through_prev_edges, row_weights, row_prev_edges, count);
+}
+
+void RelaxRowMinPlus(MinPlusKernel kernel, uint32_t weight_from, PackedEdgeId prev_edge_from,
+                     const uint32_t* through_weights, const PackedEdgeId* through_prev_edges,
+                     uint32_t* row_weights, PackedEdgeId* row_prev_edges, size_t count) {
+    RelaxRowWithKernel(kernel, weight_from, prev_edge_from, through_weights,
+                       through_prev_edges, row_weights, row_prev_edges, count);
+}
+
+} // namespace detail
+
+} // namespace graph
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+namespace graph {
+
+namespace detail {
+
+using PackedEdgeId = uint32_t;
+inline constexpr PackedEdgeId NO_EDGE = std::numeric_limits<PackedEdgeId>::max();
+
+enum class MinPlusKernel {
+    SCALAR,
+    SSE4,
+    AVX2,
+};
+
+// Kernel picked for this CPU on first use.
+MinPlusKernel GetMinPlusKernel();
+
+// For every i in [0, count): if weight_from + through_weights[i] < row_weights[i],
+// stores the sum there and sets row_prev_edges[i] to through_prev_edges[i],
+// or to prev_edge_from when the latter is NO_EDGE. Missing routes are +infinity.
+void RelaxRowMinPlus(double weight_from, PackedEdgeId prev_edge_from,
+                     const double* through_weights, const PackedEdgeId* through_prev_edges,
+                     double* row_weights, PackedEdgeId* row_prev_edges, size_t count);
+
+// The same with the given kernel, which must not be above GetMinPlusKernel();
+// bench/min_plus_kernel_benchmark.cpp runs each of them against the scalar one.
+void RelaxRowMinPlus(MinPlusKernel kernel, double weight_from, PackedEdgeId prev_edge_from,
+                     const double* through_weights, const PackedEdgeId* through_prev_edges,
+                     double* row_weights, PackedEdgeId* row_prev_edges, size_t count);
+
+// The same for single precision and fixed-point weights, eight lanes per AVX2
+// register instead of four. Fixed-point weights mark missing routes with their
+// maximum, and sums that would overflow count as no improvement.
+void RelaxRowMinPlus(float weight_from, PackedEdgeId prev_edge_from,
+                     const float* through_weights, const PackedEdgeId* through_prev_edges,
+                     float* row_weights, PackedEdgeId* row_prev_edges, size_t count);
+
+void RelaxRowMinPlus(MinPlusKernel kernel, float weight_from, PackedEdgeId prev_edge_from,
+                     const float* through_weights, const PackedEdgeId* through_prev_edges,
+                     float* row_weights, PackedEdgeId* row_prev_edges, size_t count);
+
+void RelaxRowMinPlus(uint32_t weight_from, PackedEdgeId prev_edge_from,
+                     const uint32_t* through_weights, const PackedEdgeId* through_prev_edges,
+                     uint32_t* row_weights, PackedEdgeId* row_prev_edges, size_t count);
+
+void RelaxRowMinPlus(MinPlusKernel kernel, uint32_t weight_from, PackedEdgeId prev_edge_from,
+                     const uint32_t* through_weights, const PackedEdgeId* through_prev_edges,
+                     uint32_t* row_weights, PackedEdgeId* row_prev_edges, size_t count);
+
+// Weight types with a RelaxRowMinPlus kernel.
+template <typename Weight>
+inline constexpr bool HAS_MIN_PLUS_KERNEL = std::is_same_v<Weight, double>
+                                            || std::is_same_v<Weight, float>
+                                            || std::is_same_v<Weight, uint32_t>;
+
+} // namespace detail
+
+} // namespace graph
@@ -0,0 +1,126 @@
+#include "perfect_hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+namespace perfect_hash {
+
+namespace {
+
+uint64_t MixBits(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+// Maps the low 32 bits of value onto [0, range) without a division.
+uint32_t ReduceToRange(uint64_t value, size_t range) {
+    return static_cast<uint32_t>(((value & 0xFFFFFFFFULL) * range) >> 32);
+}
+
+} // namespace
+
+MinimalPerfectHash::MinimalPerfectHash(const std::vector<std::string_view>& keys)
+    : seeds_(std::max<size_t>(1, (keys.size() + BUCKET_SIZE - 1) / BUCKET_SIZE), 0)
+    , indexes_(keys.size(), 0)
+{
+    if (keys.size() > UINT32_MAX) {
+        throw std::length_error("Too many keys for the perfect hash");
+    }
+    std::vector<uint64_t> key_hashes(keys.size());
+    std::transform(keys.begin(), keys.end(), key_hashes.begin(), HashKey);
+    {
+        std::vector<uint64_t> sorted_hashes = key_hashes;
+        std::sort(sorted_hashes.begin(), sorted_hashes.end());
+        if (std::adjacent_find(sorted_hashes.begin(), sorted_hashes.end()) != sorted_hashes.end()) {
+            throw std::invalid_argument("Keys should be distinct");
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> buckets(seeds_.size());
+    for (uint32_t index = 0; index < keys.size(); ++index) {
+        buckets[GetBucket(key_hashes[index])].push_back(index);
+    }
+    std::vector<uint32_t> bucket_order(buckets.size());
+    std::iota(bucket_order.begin(), bucket_order.end(), 0);
+    std::stable_sort(bucket_order.begin(), bucket_order.end(), [&buckets](uint32_t lhs, uint32_t rhs) {
+        return buckets[lhs].size() > buckets[rhs].size();
+    });
+
+    // Distinct hashes are enough for every bucket to find a seed eventually; the
+    // last single-key buckets take about as many tries as there are keys.
+    std::vector<bool> taken_slots(keys.size(), false);
+    std::vector<uint32_t> slots;
+    for (const uint32_t bucket : bucket_order) {
+        const auto& bucket_keys = buckets[bucket];
+        if (bucket_keys.empty()) {
+            break;
+        }
+        for (uint32_t seed = 0;; ++seed) {
+            slots.clear();
+            for (const uint32_t index : bucket_keys) {
+                const uint32_t slot = GetSlot(key_hashes[index], seed, keys.size());
+                if (taken_slots[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                    break;
+                }
+                slots.push_back(slot);
+            }
+            if (slots.size() == bucket_keys.size()) {
+                seeds_[bucket] = seed;
+                break;
+            }
+        }
+        for (size_t i = 0; i < slots.size(); ++i) {
+            taken_slots[slots[i]] = true;
+            indexes_[slots[i]] = bucket_keys[i];
+        }
+    }
+}
+
+uint64_t MinimalPerfectHash::HashKey(std::string_view key) {
+    // One multiply per eight bytes. Keys of eight bytes or more end with the
+    // last eight, which may overlap the word before; shorter ones are padded
+    // with zeros. Either way the length is mixed in first.
+    uint64_t hash = key.size() * 0x9E3779B97F4A7C15ULL;
+    const auto add_word = [&hash](uint64_t word) {
+        hash = (hash ^ word) * 0xBF58476D1CE4E5B9ULL;
+        hash ^= hash >> 31;
+    };
+    uint64_t word = 0;
+    if (key.size() >= sizeof(word)) {
+        for (size_t offset = 0; offset + sizeof(word) < key.size(); offset += sizeof(word)) {
+            std::memcpy(&word, key.data() + offset, sizeof(word));
+            add_word(word);
+        }
+        std::memcpy(&word, key.data() + key.size() - sizeof(word), sizeof(word));
+    } else {
+        for (size_t i = 0; i < key.size(); ++i) {
+            word |= static_cast<uint64_t>(static_cast<unsigned char>(key[i])) << (8 * i);
+        }
+    }
+    add_word(word);
+    return MixBits(hash);
+}
+
+uint32_t MinimalPerfectHash::GetSlot(uint64_t key_hash, uint32_t seed, size_t slot_count) {
+    return ReduceToRange(MixBits(key_hash + seed * 0x9E3779B97F4A7C15ULL), slot_count);
+}
+
+uint32_t MinimalPerfectHash::GetBucket(uint64_t key_hash) const {
+    return ReduceToRange(key_hash >> 32, seeds_.size());
+}
+
+uint32_t MinimalPerfectHash::GetIndex(std::string_view key) const {
+    const uint64_t key_hash = HashKey(key);
+    return indexes_[GetSlot(key_hash, seeds_[GetBucket(key_hash)], indexes_.size())];
+}
+
+size_t MinimalPerfectHash::GetKeyCount() const {
+    return indexes_.size();
+}
+
+} // namespace perfect_hash
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace perfect_hash {
+
+// Minimal perfect hash over a fixed set of distinct strings, built by hash and
+// displace (CHD). One hash splits the keys into small buckets, and every bucket,
+// largest first, looks for a seed that sends all of its keys to free slots of a
+// table with exactly one slot per key. A lookup hashes the key once and reads
+// the seed of its bucket and the slot that seed picks.
+class MinimalPerfectHash {
+public:
+    MinimalPerfectHash() = default;
+    explicit MinimalPerfectHash(const std::vector<std::string_view>& keys);
+
+    // Index of the key in the vector the hash was built from. Other strings get
+    // some index below the key count as well, so callers compare the key stored
+    // there. The hash must not be empty.
+    uint32_t GetIndex(std::string_view key) const;
+
+    size_t GetKeyCount() const;
+
+private:
+    // Average number of keys per bucket.
+    static constexpr size_t BUCKET_SIZE = 4;
+
+    static uint64_t HashKey(std::string_view key);
+    static uint32_t GetSlot(uint64_t key_hash, uint32_t seed, size_t slot_count);
+    uint32_t GetBucket(uint64_t key_hash) const;
+
+    std::vector<uint32_t> seeds_;
+    // Index of the key in each slot.
+    std::vector<uint32_t> indexes_;
+};
+
+} // namespace perfect_hash
@@ -0,0 +1,142 @@
+#include "raptor_router.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace transport_router {
+
+RaptorRouter::RaptorRouter(const BusLines& lines
+                           , double bus_wait_time
+                           , double bus_velocity)
+    : bus_wait_time_(bus_wait_time)
+    , bus_velocity_(bus_velocity)
+    , lines_(lines) {
+    stop_visits_.resize(lines.GetStopCount());
+    for (const BusLine& line : lines.GetLines()) {
+        if (!line.bus->is_roundtrip) {
+            AddPattern(line.bus, line.GetReverseStops(), line.GetReverseDistances());
+        }
+        AddPattern(line.bus, line.stops, line.forward_distances);
+    }
+}
+
+void RaptorRouter::AddPattern(const transport_catalogue::Bus* bus
+                              , std::vector<size_t> stops
+                              , std::vector<int64_t> distances) {
+    for (size_t position = 0; position < stops.size(); ++position) {
+        stop_visits_[stops[position]].push_back({patterns_.size(), position});
+    }
+    patterns_.push_back({bus, std::move(stops), std::move(distances)});
+}
+
+double RaptorRouter::GetRideTime(const Pattern& pattern
+                                 , size_t board_position
+                                 , size_t alight_position) const {
+    const int64_t distance = pattern.distances[alight_position] - pattern.distances[board_position];
+    return static_cast<double>(distance) / bus_velocity_;
+}
+
+std::vector<std::vector<graph::Edge<double>>> RaptorRouter::FindParetoRoutes(
+                                                    graph::VertexId vertex_from
+                                                    , graph::VertexId vertex_to
+                                                    , size_t max_rides) const {
+    const size_t stop_from = lines_.GetStopIndex(vertex_from);
+    const size_t stop_to = lines_.GetStopIndex(vertex_to);
+    std::vector<Round> rounds(1, Round{std::vector<std::optional<double>>(lines_.GetStopCount())
+                                       , std::vector<std::optional<Leg>>(lines_.GetStopCount())});
+    rounds[0].times[stop_from] = 0.0;
+    std::vector<size_t> marked_stops{stop_from};
+    // The earliest position in each pattern at which a marked stop can board.
+    std::vector<std::optional<size_t>> pattern_starts(patterns_.size());
+    std::vector<size_t> marked_patterns;
+    std::vector<size_t> improving_rounds;
+
+    for (size_t round = 1; round <= max_rides && !marked_stops.empty(); ++round) {
+        marked_patterns.clear();
+        for (const size_t stop : marked_stops) {
+            for (const StopVisit& visit : stop_visits_[stop]) {
+                auto& start = pattern_starts[visit.pattern];
+                if (!start) {
+                    marked_patterns.push_back(visit.pattern);
+                    start = visit.position;
+                } else {
+                    start = std::min(*start, visit.position);
+                }
+            }
+        }
+        marked_stops.clear();
+
+        rounds.push_back(Round{rounds.back().times, std::vector<std::optional<Leg>>(lines_.GetStopCount())});
+        const Round& previous = rounds[round - 1];
+        Round& current = rounds[round];
+        for (const size_t pattern_index : marked_patterns) {
+            const Pattern& pattern = patterns_[pattern_index];
+            std::optional<size_t> board_position;
+            for (size_t position = *pattern_starts[pattern_index]; position < pattern.stops.size(); ++position) {
+                const size_t stop = pattern.stops[position];
+                std::optional<double> on_board_time;
+                if (board_position) {
+                    on_board_time = *previous.times[pattern.stops[*board_position]] + bus_wait_time_
+                                    + GetRideTime(pattern, *board_position, position);
+                    auto& time = current.times[stop];
+                    const auto& target_time = current.times[stop_to];
+                    if ((!time || *on_board_time < *time) && (!target_time || *on_board_time < *target_time)) {
+                        time = on_board_time;
+                        current.legs[stop] = Leg{pattern_index, *board_position, position};
+                        marked_stops.push_back(stop);
+                    }
+                }
+                const auto& previous_time = previous.times[stop];
+                if (previous_time && (!on_board_time || *previous_time + bus_wait_time_ < *on_board_time)) {
+                    board_position = position;
+                }
+            }
+            pattern_starts[pattern_index].reset();
+        }
+        std::sort(marked_stops.begin(), marked_stops.end());
+        marked_stops.erase(std::unique(marked_stops.begin(), marked_stops.end()), marked_stops.end());
+        if (current.legs[stop_to]) {
+            improving_rounds.push_back(round);
+        }
+    }
+
+    std::vector<std::vector<graph::Edge<double>>> result;
+    if (stop_from == stop_to) {
+        result.emplace_back();
+    }
+    for (const size_t round : improving_rounds) {
+        result.push_back(BuildEdges(rounds, round, stop_from, stop_to));
+    }
+    return result;
+}
+
+std::vector<graph::Edge<double>> RaptorRouter::BuildEdges(const std::vector<Round>& rounds
+                                                          , size_t round
+                                                          , size_t stop_from
+                                                          , size_t stop_to) const {
+    std::vector<graph::Edge<double>> edges;
+    for (size_t stop = stop_to; stop != stop_from; --round) {
+        // The stop keeps its time from the last round that improved it.
+        while (!rounds[round].legs[stop]) {
+            --round;
+        }
+        const Leg& leg = *rounds[round].legs[stop];
+        const Pattern& pattern = patterns_[leg.pattern];
+        const size_t board_stop = pattern.stops[leg.board_position];
+        edges.push_back({pattern.bus->id
+                        , static_cast<uint32_t>(leg.alight_position - leg.board_position)
+                        , lines_.GetStopVertex(board_stop) + 1
+                        , lines_.GetStopVertex(stop)
+                        , GetRideTime(pattern, leg.board_position, leg.alight_position)});
+        edges.push_back({lines_.GetStop(board_stop).id
+                        , 0
+                        , lines_.GetStopVertex(board_stop)
+                        , lines_.GetStopVertex(board_stop) + 1
+                        , bus_wait_time_});
+        stop = board_stop;
+    }
+    std::reverse(edges.begin(), edges.end());
+    return edges;
+}
+
+} // namespace transport_router
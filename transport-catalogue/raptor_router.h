@@ -0,0 +1,80 @@
+#pragma once
+
+#include "bus_lines.h"
+#include "graph.h"
+#include "transport_catalogue.h"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace transport_router {
+
+// Round-based public transit routing (RAPTOR) over the bus routes of the
+// catalogue. Round k scans every bus route touched by a stop improved in round
+// k - 1, so after it each stop holds the fastest arrival with at most k rides.
+// Every round that still improves the destination contributes one route to the
+// Pareto set of (time, transfers). Times follow the same model as the graph:
+// bus_wait_time for each boarding plus road distance over bus_velocity.
+class RaptorRouter {
+public:
+    // Keeps a reference to lines, which must outlive the router.
+    RaptorRouter(const BusLines& lines
+                 , double bus_wait_time
+                 , double bus_velocity);
+
+    // Routes that are each faster than every route with fewer transfers, in
+    // order of transfer count, using at most max_rides buses. Routes come out as
+    // the wait and ride edges TransportRouter::FillEdges would have created.
+    std::vector<std::vector<graph::Edge<double>>> FindParetoRoutes(
+                                                graph::VertexId vertex_from
+                                                , graph::VertexId vertex_to
+                                                , size_t max_rides = NO_RIDE_LIMIT) const;
+
+    static constexpr size_t NO_RIDE_LIMIT = std::numeric_limits<size_t>::max();
+
+private:
+    // A bus route in one travel direction. A route that is not a roundtrip is
+    // scanned once in each direction.
+    struct Pattern {
+        const transport_catalogue::Bus* bus = nullptr;
+        std::vector<size_t> stops;
+        // Road distance from the first stop of the pattern to each of its stops.
+        std::vector<int64_t> distances;
+    };
+
+    struct StopVisit {
+        size_t pattern;
+        size_t position;
+    };
+
+    struct Leg {
+        size_t pattern;
+        size_t board_position;
+        size_t alight_position;
+    };
+
+    struct Round {
+        std::vector<std::optional<double>> times;
+        // The ride by which the stop was improved in this round.
+        std::vector<std::optional<Leg>> legs;
+    };
+
+    void AddPattern(const transport_catalogue::Bus* bus
+                    , std::vector<size_t> stops
+                    , std::vector<int64_t> distances);
+    double GetRideTime(const Pattern& pattern, size_t board_position, size_t alight_position) const;
+    std::vector<graph::Edge<double>> BuildEdges(const std::vector<Round>& rounds
+                                                , size_t round
+                                                , size_t stop_from
+                                                , size_t stop_to) const;
+
+    double bus_wait_time_ = 0.0;
+    double bus_velocity_ = 0.0;
+    const BusLines& lines_;
+    std::vector<Pattern> patterns_;
+    std::vector<std::vector<StopVisit>> stop_visits_;
+};
+
+} // namespace transport_router
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "graph.h"
+#include "min_plus_kernel.h"
+#include "router.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// All-pairs table restricted to the vertices routes may start and end at. Every
+// other vertex must have exactly one incoming edge, so a route always enters it
+// the same way and only the last edge into each query vertex has to be stored.
+// The table is filled by one Dijkstra search per query vertex.
+template <typename Weight>
+class ReducedRouter {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+public:
+    using RouteInfo = graph::RouteInfo<Weight>;
+
+    // Fills the rows of the table over pool.
+    ReducedRouter(const Graph& graph, const std::vector<VertexId>& query_vertices,
+                  thread_pool::ThreadPool& pool);
+
+    // Both vertices must be among the query vertices; the table answers without
+    // a search, so stats stay zero.
+    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to,
+                                        SearchStats* stats = nullptr) const;
+
+private:
+    using PackedEdgeId = detail::PackedEdgeId;
+    using QueueItem = std::pair<Weight, VertexId>;
+    using Queue = std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>>;
+
+    static constexpr Weight ZERO_WEIGHT{};
+    static constexpr Weight NO_ROUTE = std::numeric_limits<Weight>::has_infinity
+                                           ? std::numeric_limits<Weight>::infinity()
+                                           : std::numeric_limits<Weight>::max();
+    static constexpr PackedEdgeId NO_EDGE = detail::NO_EDGE;
+    static constexpr size_t NO_INDEX = std::numeric_limits<size_t>::max();
+
+    size_t GetQueryIndex(VertexId vertex) const;
+    void FillRow(size_t source_index);
+
+    const Graph& graph_;
+    std::vector<VertexId> query_vertices_;
+    // Position of each vertex in query_vertices_, NO_INDEX for the rest.
+    std::vector<size_t> query_indexes_;
+    // The only incoming edge of every vertex outside query_vertices_.
+    std::vector<PackedEdgeId> single_incoming_edges_;
+    // Row-major query_vertices_.size() squared tables of route weights and the
+    // last edge of each route.
+    std::vector<Weight> weights_;
+    std::vector<PackedEdgeId> prev_edges_;
+};
+
+template <typename Weight>
+ReducedRouter<Weight>::ReducedRouter(const Graph& graph,
+                                     const std::vector<VertexId>& query_vertices,
+                                     thread_pool::ThreadPool& pool)
+    : graph_(graph)
+    , query_vertices_(query_vertices)
+    , query_indexes_(graph.GetVertexCount(), NO_INDEX)
+    , single_incoming_edges_(graph.GetVertexCount(), NO_EDGE)
+    , weights_(query_vertices.size() * query_vertices.size(), NO_ROUTE)
+    , prev_edges_(query_vertices.size() * query_vertices.size(), NO_EDGE)
+{
+    if (graph.GetEdgeCount() >= NO_EDGE) {
+        throw std::length_error("Too many edges for the route table");
+    }
+    CheckNonNegativeWeights(graph);
+    for (size_t index = 0; index < query_vertices_.size(); ++index) {
+        query_indexes_.at(query_vertices_[index]) = index;
+    }
+
+    std::vector<size_t> incoming_counts(graph.GetVertexCount(), 0);
+    for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+        const auto& edge = graph.GetEdge(edge_id);
+        ++incoming_counts[edge.to];
+        single_incoming_edges_[edge.to] = static_cast<PackedEdgeId>(edge_id);
+    }
+    for (VertexId vertex = 0; vertex < graph.GetVertexCount(); ++vertex) {
+        if (query_indexes_[vertex] == NO_INDEX && incoming_counts[vertex] > 1) {
+            throw std::invalid_argument("Vertices outside the table should have a single incoming edge");
+        }
+    }
+
+    pool.ParallelFor(query_vertices_.size(), [this](size_t source_index) {
+        FillRow(source_index);
+    });
+}
+
+template <typename Weight>
+void ReducedRouter<Weight>::FillRow(size_t source_index) {
+    std::vector<std::optional<Weight>> distances(graph_.GetVertexCount());
+    Queue queue;
+    const VertexId source = query_vertices_[source_index];
+    distances[source] = ZERO_WEIGHT;
+    queue.push({ZERO_WEIGHT, source});
+
+    Weight* const row_weights = weights_.data() + source_index * query_vertices_.size();
+    PackedEdgeId* const row_prev_edges = prev_edges_.data() + source_index * query_vertices_.size();
+    row_weights[source_index] = ZERO_WEIGHT;
+
+    while (!queue.empty()) {
+        const auto [distance, vertex] = queue.top();
+        queue.pop();
+        if (distance > *distances[vertex]) {
+            continue;
+        }
+        for (const EdgeId edge_id : graph_.GetIncidentEdges(vertex)) {
+            const auto& edge = graph_.GetEdge(edge_id);
+            const Weight candidate = distance + edge.weight;
+            auto& next_distance = distances[edge.to];
+            if (!next_distance || candidate < *next_distance) {
+                next_distance = candidate;
+                queue.push({candidate, edge.to});
+                if (const size_t target_index = query_indexes_[edge.to]; target_index != NO_INDEX) {
+                    row_weights[target_index] = candidate;
+                    row_prev_edges[target_index] = static_cast<PackedEdgeId>(edge_id);
+                }
+            }
+        }
+    }
+}
+
+template <typename Weight>
+size_t ReducedRouter<Weight>::GetQueryIndex(VertexId vertex) const {
+    if (vertex >= query_indexes_.size() || query_indexes_[vertex] == NO_INDEX) {
+        throw std::out_of_range("Vertex is not in the route table");
+    }
+    return query_indexes_[vertex];
+}
+
+template <typename Weight>
+std::optional<typename ReducedRouter<Weight>::RouteInfo> ReducedRouter<Weight>::BuildRoute(
+                                                                    VertexId from,
+                                                                    VertexId to,
+                                                                    SearchStats* stats) const {
+    if (stats) {
+        *stats = SearchStats{};
+    }
+    const size_t row_offset = GetQueryIndex(from) * query_vertices_.size();
+    const Weight weight = weights_[row_offset + GetQueryIndex(to)];
+    if (weight == NO_ROUTE) {
+        return std::nullopt;
+    }
+
+    std::vector<EdgeId> edges;
+    for (PackedEdgeId edge_id = prev_edges_[row_offset + query_indexes_[to]]; edge_id != NO_EDGE;) {
+        edges.push_back(edge_id);
+        const VertexId vertex = graph_.GetEdge(edge_id).from;
+        edge_id = query_indexes_[vertex] == NO_INDEX
+                      ? single_incoming_edges_[vertex]
+                      : prev_edges_[row_offset + query_indexes_[vertex]];
+    }
+    std::reverse(edges.begin(), edges.end());
+
+    return RouteInfo{weight, std::move(edges)};
+}
+
+}  // namespace graph
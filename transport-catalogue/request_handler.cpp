@@ -13,15 +13,65 @@ transport_catalogue::BusRouteInfo RequestHandler::GetBusRouteInfo(
     return catalogue_.GetBusInfo(bus_name);
 }
 
-const std::unordered_set<std::string_view>& RequestHandler::GetBusesByStop(
+std::vector<std::string_view> RequestHandler::GetBusesByStop(
                                     const std::string_view& stop_name) const {
     return catalogue_.GetStopInfo(stop_name);
 }
 
-const std::optional<std::vector<graph::Edge<double>>> RequestHandler::GetOptimalRoute(const std::string_view stop_from, const std::string_view stop_to) const {
+std::optional<transport_router::RouteView> RequestHandler::GetOptimalRoute(const std::string_view stop_from
+                                                                           , const std::string_view stop_to) const {
     return router_.FindRoute(stop_from, stop_to);
 }
 
+std::optional<double> RequestHandler::GetRouteTime(const std::string_view stop_from
+                                                   , const std::string_view stop_to) const {
+    return router_.FindRouteTime(stop_from, stop_to);
+}
+
+std::optional<std::vector<graph::Edge<double>>> RequestHandler::GetScheduledRoute(
+                                        const std::string_view stop_from
+                                        , const std::string_view stop_to
+                                        , double departure_time) const {
+    return router_.FindRouteAt(stop_from, stop_to, departure_time);
+}
+
+std::vector<std::vector<graph::Edge<double>>> RequestHandler::GetAlternativeRoutes(
+                                        const std::string_view stop_from
+                                        , const std::string_view stop_to
+                                        , size_t route_count) const {
+    return router_.FindAlternativeRoutes(stop_from, stop_to, route_count);
+}
+
+std::vector<std::vector<graph::Edge<double>>> RequestHandler::GetParetoRoutes(
+                                        const std::string_view stop_from
+                                        , const std::string_view stop_to
+                                        , std::optional<size_t> max_transfers) const {
+    return router_.FindParetoRoutes(stop_from, stop_to, max_transfers);
+}
+
+std::vector<std::vector<std::optional<double>>> RequestHandler::GetRouteTimeMatrix(
+                                        const std::vector<std::string_view>& stops_from
+                                        , const std::vector<std::string_view>& stops_to) const {
+    return router_.ComputeTimeMatrix(stops_from, stops_to);
+}
+
+std::vector<std::pair<std::string_view, double>> RequestHandler::GetReachableStops(
+                                        const std::string_view stop_from, double max_time) const {
+    return router_.FindReachableStops(stop_from, max_time);
+}
+
+lru_cache::CacheStats RequestHandler::GetRouteCacheStats() const {
+    return router_.GetRouteCacheStats();
+}
+
+std::string_view RequestHandler::GetStopName(uint32_t stop_id) const {
+    return catalogue_.GetStopById(stop_id).name;
+}
+
+std::string_view RequestHandler::GetBusName(uint32_t bus_id) const {
+    return catalogue_.GetBusById(bus_id).name;
+}
+
 svg::Document RequestHandler::RenderMap() const {
     return renderer_.CreateSvgDoc(catalogue_.GetAllBuses());
 }
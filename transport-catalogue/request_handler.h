@@ -18,11 +18,33 @@ RequestHandler(const transport_catalogue::TransportCatalogue& catalogue
     bool IsBusExist(const std::string_view bus_name) const;
     transport_catalogue::BusRouteInfo GetBusRouteInfo(
                                         const std::string_view& bus_name) const;
-    const std::unordered_set<std::string_view>& GetBusesByStop(
+    std::vector<std::string_view> GetBusesByStop(
                                         const std::string_view& stop_name) const;
-    const std::optional<std::vector<graph::Edge<double>>> GetOptimalRoute(
-                                                                        const std::string_view stop_from
-                                                                        , const std::string_view stop_to) const;
+    std::optional<transport_router::RouteView> GetOptimalRoute(const std::string_view stop_from
+                                                               , const std::string_view stop_to) const;
+    std::optional<double> GetRouteTime(const std::string_view stop_from
+                                       , const std::string_view stop_to) const;
+    std::optional<std::vector<graph::Edge<double>>> GetScheduledRoute(
+                                        const std::string_view stop_from
+                                        , const std::string_view stop_to
+                                        , double departure_time) const;
+    std::vector<std::vector<graph::Edge<double>>> GetAlternativeRoutes(
+                                        const std::string_view stop_from
+                                        , const std::string_view stop_to
+                                        , size_t route_count) const;
+    std::vector<std::vector<graph::Edge<double>>> GetParetoRoutes(
+                                        const std::string_view stop_from
+                                        , const std::string_view stop_to
+                                        , std::optional<size_t> max_transfers) const;
+    std::vector<std::vector<std::optional<double>>> GetRouteTimeMatrix(
+                                        const std::vector<std::string_view>& stops_from
+                                        , const std::vector<std::string_view>& stops_to) const;
+    std::vector<std::pair<std::string_view, double>> GetReachableStops(
+                                        const std::string_view stop_from, double max_time) const;
+    lru_cache::CacheStats GetRouteCacheStats() const;
+    // Names behind graph::Edge::name_id of wait and ride edges respectively.
+    std::string_view GetStopName(uint32_t stop_id) const;
+    std::string_view GetBusName(uint32_t bus_id) const;
     svg::Document RenderMap() const;
 
 private:
@@ -1,117 +1,481 @@
 #pragma once
 
 #include "graph.h"
+#include "mapped_file.h"
+#include "min_plus_kernel.h"
+#include "thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <queue>
+#include <tuple>
+#include <type_traits>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace graph {
 
+template <typename Weight>
+struct RouteInfo {
+    Weight weight;
+    std::vector<EdgeId> edges;
+};
+
+// Filled in by search-based routers for every query.
+struct SearchStats {
+    size_t settled_vertices = 0;
+};
+
 template <typename Weight>
 class Router {
 private:
     using Graph = DirectedWeightedGraph<Weight>;
 
 public:
-    explicit Router(const Graph& graph);
+    // With more than one thread in pool the precompute runs as a blocked
+    // Floyd-Warshall over it.
+    Router(const Graph& graph, thread_pool::ThreadPool& pool);
 
-    struct RouteInfo {
-        Weight weight;
-        std::vector<EdgeId> edges;
-    };
+    using RouteInfo = graph::RouteInfo<Weight>;
+
+    // The table answers without a search, so stats stay zero.
+    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to,
+                                        SearchStats* stats = nullptr) const;
+
+    // Writes the route table to a versioned binary file tagged with the graph
+    // fingerprint. Returns false if the file could not be written.
+    bool SaveToFile(const std::string& path) const;
 
-    std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+    // Maps a file written by SaveToFile without parsing it. Returns nullptr if
+    // the file is missing, has another format version or was built for another graph.
+    static std::unique_ptr<Router> LoadFromFile(const Graph& graph, const std::string& path);
+
+    // Repairs the table after the graph it was built for has been replaced by
+    // one with the same vertices; old_graph is the graph before the change.
+    // Both graphs must be frozen. Rows with a route through a removed or changed
+    // edge are searched again, and added edges are spliced in by Floyd-Warshall
+    // steps through their endpoints only, so the cost grows with the change.
+    // Rows are checked and searched again over pool.
+    void Update(const Graph& old_graph, thread_pool::ThreadPool& pool);
 
 private:
-    struct RouteInternalData {
-        Weight weight;
-        std::optional<EdgeId> prev_edge;
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t weight_size;
+        uint64_t vertex_count;
+        uint64_t edge_count;
+        uint64_t graph_fingerprint;
     };
-    using RoutesInternalData = std::vector<std::vector<std::optional<RouteInternalData>>>;
+    static constexpr char FILE_MAGIC[8] = {'T', 'C', 'R', 'O', 'U', 'T', 'E', '\0'};
+    static constexpr uint32_t FILE_VERSION = 1;
+    static constexpr size_t FILE_ALIGNMENT = 64;
+
+    static size_t AlignFileOffset(size_t offset) {
+        return (offset + FILE_ALIGNMENT - 1) / FILE_ALIGNMENT * FILE_ALIGNMENT;
+    }
+
+    Router(const Graph& graph, mapped_file::MappedFile file);
+
+    // Edge ids are packed into 32 bits to keep the table compact.
+    using PackedEdgeId = detail::PackedEdgeId;
+
+    static constexpr Weight ZERO_WEIGHT{};
+    static constexpr Weight NO_ROUTE = std::numeric_limits<Weight>::has_infinity
+                                           ? std::numeric_limits<Weight>::infinity()
+                                           : std::numeric_limits<Weight>::max();
+    static constexpr PackedEdgeId NO_EDGE = detail::NO_EDGE;
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    size_t GetCellIndex(VertexId vertex_from, VertexId vertex_to) const {
+        return vertex_from * vertex_count_ + vertex_to;
+    }
 
     void InitializeRoutesInternalData(const Graph& graph) {
-        const size_t vertex_count = graph.GetVertexCount();
-        for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
-            routes_internal_data_[vertex][vertex] = RouteInternalData{ZERO_WEIGHT, std::nullopt};
+        if (graph.GetEdgeCount() >= NO_EDGE) {
+            throw std::length_error("Too many edges for the route table");
+        }
+        CheckNonNegativeWeights(graph);
+        for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+            weights_[GetCellIndex(vertex, vertex)] = ZERO_WEIGHT;
             for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
                 const auto& edge = graph.GetEdge(edge_id);
-                if (edge.weight < ZERO_WEIGHT) {
-                    throw std::domain_error("Edges' weights should be non-negative");
+                const size_t cell = GetCellIndex(vertex, edge.to);
+                if (weights_[cell] > edge.weight) {
+                    weights_[cell] = edge.weight;
+                    prev_edges_[cell] = static_cast<PackedEdgeId>(edge_id);
                 }
-                auto& route_internal_data = routes_internal_data_[vertex][edge.to];
-                if (!route_internal_data || route_internal_data->weight > edge.weight) {
-                    route_internal_data = RouteInternalData{edge.weight, edge_id};
+            }
+        }
+    }
+
+    // Relaxes routes from vertex_from to [to_begin, to_end) through vertex_through.
+    void RelaxRowThroughVertex(VertexId vertex_from, VertexId vertex_through,
+                               VertexId to_begin, VertexId to_end) {
+        const size_t cell_from = GetCellIndex(vertex_from, vertex_through);
+        const Weight weight_from = weights_[cell_from];
+        if (weight_from == NO_ROUTE) {
+            return;
+        }
+        const PackedEdgeId prev_edge_from = prev_edges_[cell_from];
+        Weight* const row_weights = weights_.data() + GetCellIndex(vertex_from, 0);
+        PackedEdgeId* const row_prev_edges = prev_edges_.data() + GetCellIndex(vertex_from, 0);
+        const Weight* const through_weights = weights_.data() + GetCellIndex(vertex_through, 0);
+        const PackedEdgeId* const through_prev_edges =
+            prev_edges_.data() + GetCellIndex(vertex_through, 0);
+
+        if constexpr (detail::HAS_MIN_PLUS_KERNEL<Weight>) {
+            detail::RelaxRowMinPlus(weight_from, prev_edge_from,
+                                    through_weights + to_begin, through_prev_edges + to_begin,
+                                    row_weights + to_begin, row_prev_edges + to_begin,
+                                    to_end - to_begin);
+        } else {
+            for (VertexId vertex_to = to_begin; vertex_to < to_end; ++vertex_to) {
+                if (through_weights[vertex_to] == NO_ROUTE) {
+                    continue;
+                }
+                const Weight candidate_weight = weight_from + through_weights[vertex_to];
+                if (candidate_weight < row_weights[vertex_to]) {
+                    row_weights[vertex_to] = candidate_weight;
+                    row_prev_edges[vertex_to] = through_prev_edges[vertex_to] != NO_EDGE
+                                                    ? through_prev_edges[vertex_to]
+                                                    : prev_edge_from;
                 }
             }
         }
     }
 
-    void RelaxRoute(VertexId vertex_from, VertexId vertex_to, const RouteInternalData& route_from,
-                    const RouteInternalData& route_to) {
-        auto& route_relaxing = routes_internal_data_[vertex_from][vertex_to];
-        const Weight candidate_weight = route_from.weight + route_to.weight;
-        if (!route_relaxing || candidate_weight < route_relaxing->weight) {
-            route_relaxing = {candidate_weight,
-                              route_to.prev_edge ? route_to.prev_edge : route_from.prev_edge};
+    void RelaxRoutesInternalDataThroughVertex(VertexId vertex_through) {
+        for (VertexId vertex_from = 0; vertex_from < vertex_count_; ++vertex_from) {
+            RelaxRowThroughVertex(vertex_from, vertex_through, 0, vertex_count_);
         }
     }
 
-    void RelaxRoutesInternalDataThroughVertex(size_t vertex_count, VertexId vertex_through) {
-        for (VertexId vertex_from = 0; vertex_from < vertex_count; ++vertex_from) {
-            if (const auto& route_from = routes_internal_data_[vertex_from][vertex_through]) {
-                for (VertexId vertex_to = 0; vertex_to < vertex_count; ++vertex_to) {
-                    if (const auto& route_to = routes_internal_data_[vertex_through][vertex_to]) {
-                        RelaxRoute(vertex_from, vertex_to, *route_from, *route_to);
-                    }
-                }
+    std::pair<VertexId, VertexId> GetBlockBounds(size_t block) const {
+        const VertexId begin = block * BLOCK_SIZE;
+        return {begin, std::min(begin + BLOCK_SIZE, vertex_count_)};
+    }
+
+    void RelaxBlockThroughBlock(size_t block_through, size_t block_from, size_t block_to) {
+        const auto [through_begin, through_end] = GetBlockBounds(block_through);
+        const auto [from_begin, from_end] = GetBlockBounds(block_from);
+        const auto [to_begin, to_end] = GetBlockBounds(block_to);
+        for (VertexId vertex_through = through_begin; vertex_through < through_end; ++vertex_through) {
+            for (VertexId vertex_from = from_begin; vertex_from < from_end; ++vertex_from) {
+                RelaxRowThroughVertex(vertex_from, vertex_through, to_begin, to_end);
             }
         }
     }
 
-    static constexpr Weight ZERO_WEIGHT{};
+    // Each phase finalizes the diagonal block first, then the blocks sharing its
+    // row or column, then all the rest. Blocks within a step are independent.
+    void RelaxRoutesInternalDataBlocked(thread_pool::ThreadPool& pool) {
+        const size_t block_count = (vertex_count_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        for (size_t block_through = 0; block_through < block_count; ++block_through) {
+            RelaxBlockThroughBlock(block_through, block_through, block_through);
+            pool.ParallelFor(2 * block_count, [&](size_t task) {
+                const size_t block = task / 2;
+                if (block == block_through) {
+                    return;
+                }
+                if (task % 2 == 0) {
+                    RelaxBlockThroughBlock(block_through, block_through, block);
+                } else {
+                    RelaxBlockThroughBlock(block_through, block, block_through);
+                }
+            });
+            pool.ParallelFor(block_count * block_count, [&](size_t task) {
+                const size_t block_from = task / block_count;
+                const size_t block_to = task % block_count;
+                if (block_from == block_through || block_to == block_through) {
+                    return;
+                }
+                RelaxBlockThroughBlock(block_through, block_from, block_to);
+            });
+        }
+    }
+
+    // Matches the edges of old_graph to identical edges of graph_. Fills the new
+    // id of every old edge, NO_EDGE for removed ones, and lists the added edges.
+    void MatchEdges(const Graph& old_graph, std::vector<PackedEdgeId>& new_edge_ids,
+                    std::vector<EdgeId>& added_edges) const;
+
+    // Recomputes the routes from vertex_from with a Dijkstra search over graph_.
+    void RebuildRow(VertexId vertex_from);
+
     const Graph& graph_;
-    RoutesInternalData routes_internal_data_;
+    const size_t vertex_count_;
+    // Row-major vertex_count_ x vertex_count_ tables: the best known weight and the
+    // last edge of that route, NO_ROUTE / NO_EDGE where there is none.
+    std::vector<Weight> weights_;
+    std::vector<PackedEdgeId> prev_edges_;
+    // Tables loaded by LoadFromFile live in file_ and the vectors stay empty.
+    mapped_file::MappedFile file_;
+    const Weight* weights_data_ = nullptr;
+    const PackedEdgeId* prev_edges_data_ = nullptr;
 };
 
 template <typename Weight>
-Router<Weight>::Router(const Graph& graph)
+Router<Weight>::Router(const Graph& graph, thread_pool::ThreadPool& pool)
     : graph_(graph)
-    , routes_internal_data_(graph.GetVertexCount(),
-                            std::vector<std::optional<RouteInternalData>>(graph.GetVertexCount()))
+    , vertex_count_(graph.GetVertexCount())
+    , weights_(vertex_count_ * vertex_count_, NO_ROUTE)
+    , prev_edges_(vertex_count_ * vertex_count_, NO_EDGE)
 {
     InitializeRoutesInternalData(graph);
 
+    if (pool.GetThreadCount() > 1) {
+        RelaxRoutesInternalDataBlocked(pool);
+    } else {
+        for (VertexId vertex_through = 0; vertex_through < vertex_count_; ++vertex_through) {
+            RelaxRoutesInternalDataThroughVertex(vertex_through);
+        }
+    }
+    weights_data_ = weights_.data();
+    prev_edges_data_ = prev_edges_.data();
+}
+
+template <typename Weight>
+Router<Weight>::Router(const Graph& graph, mapped_file::MappedFile file)
+    : graph_(graph)
+    , vertex_count_(graph.GetVertexCount())
+    , file_(std::move(file))
+{
+    const size_t cell_count = vertex_count_ * vertex_count_;
+    const size_t weights_offset = AlignFileOffset(sizeof(FileHeader));
+    const size_t prev_edges_offset = AlignFileOffset(weights_offset + cell_count * sizeof(Weight));
+    weights_data_ = reinterpret_cast<const Weight*>(file_.GetData() + weights_offset);
+    prev_edges_data_ = reinterpret_cast<const PackedEdgeId*>(file_.GetData() + prev_edges_offset);
+}
+
+template <typename Weight>
+bool Router<Weight>::SaveToFile(const std::string& path) const {
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream output(temp_path, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            return false;
+        }
+        FileHeader header{};
+        std::copy(std::begin(FILE_MAGIC), std::end(FILE_MAGIC), header.magic);
+        header.version = FILE_VERSION;
+        header.weight_size = sizeof(Weight);
+        header.vertex_count = vertex_count_;
+        header.edge_count = graph_.GetEdgeCount();
+        header.graph_fingerprint = ComputeGraphFingerprint(graph_);
+
+        const size_t cell_count = vertex_count_ * vertex_count_;
+        const auto write_padding = [&output](size_t written) {
+            static const char padding[FILE_ALIGNMENT] = {};
+            output.write(padding, AlignFileOffset(written) - written);
+            return AlignFileOffset(written);
+        };
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        size_t written = write_padding(sizeof(header));
+        output.write(reinterpret_cast<const char*>(weights_data_), cell_count * sizeof(Weight));
+        write_padding(written + cell_count * sizeof(Weight));
+        output.write(reinterpret_cast<const char*>(prev_edges_data_)
+                     , cell_count * sizeof(PackedEdgeId));
+        if (!output) {
+            return false;
+        }
+    }
+    return std::rename(temp_path.c_str(), path.c_str()) == 0;
+}
+
+template <typename Weight>
+std::unique_ptr<Router<Weight>> Router<Weight>::LoadFromFile(const Graph& graph,
+                                                             const std::string& path) {
+    mapped_file::MappedFile file(path);
+    if (!file.IsOpen() || file.GetSize() < sizeof(FileHeader)) {
+        return nullptr;
+    }
+    FileHeader header;
+    std::copy(file.GetData(), file.GetData() + sizeof(header), reinterpret_cast<std::byte*>(&header));
+
     const size_t vertex_count = graph.GetVertexCount();
-    for (VertexId vertex_through = 0; vertex_through < vertex_count; ++vertex_through) {
-        RelaxRoutesInternalDataThroughVertex(vertex_count, vertex_through);
+    const size_t cell_count = vertex_count * vertex_count;
+    const size_t expected_size = AlignFileOffset(AlignFileOffset(sizeof(FileHeader))
+                                                 + cell_count * sizeof(Weight))
+                                 + cell_count * sizeof(PackedEdgeId);
+    if (!std::equal(std::begin(FILE_MAGIC), std::end(FILE_MAGIC), header.magic)
+        || header.version != FILE_VERSION
+        || header.weight_size != sizeof(Weight)
+        || header.vertex_count != vertex_count
+        || header.edge_count != graph.GetEdgeCount()
+        || file.GetSize() != expected_size
+        || header.graph_fingerprint != ComputeGraphFingerprint(graph)) {
+        return nullptr;
+    }
+    return std::unique_ptr<Router>(new Router(graph, std::move(file)));
+}
+
+template <typename Weight>
+void Router<Weight>::MatchEdges(const Graph& old_graph, std::vector<PackedEdgeId>& new_edge_ids,
+                                std::vector<EdgeId>& added_edges) const {
+    const auto edge_key = [](const Edge<Weight>& edge) {
+        return std::tie(edge.to, edge.name_id, edge.span_count, edge.weight);
+    };
+    new_edge_ids.assign(old_graph.GetEdgeCount(), NO_EDGE);
+    std::vector<EdgeId> old_edges;
+    std::vector<EdgeId> new_edges;
+    for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+        const auto old_range = old_graph.GetIncidentEdges(vertex);
+        const auto new_range = graph_.GetIncidentEdges(vertex);
+        old_edges.assign(old_range.begin(), old_range.end());
+        new_edges.assign(new_range.begin(), new_range.end());
+        std::sort(old_edges.begin(), old_edges.end(), [&](EdgeId lhs, EdgeId rhs) {
+            return edge_key(old_graph.GetEdge(lhs)) < edge_key(old_graph.GetEdge(rhs));
+        });
+        std::sort(new_edges.begin(), new_edges.end(), [&](EdgeId lhs, EdgeId rhs) {
+            return edge_key(graph_.GetEdge(lhs)) < edge_key(graph_.GetEdge(rhs));
+        });
+
+        auto old_edge = old_edges.begin();
+        for (const EdgeId new_edge : new_edges) {
+            const auto new_key = edge_key(graph_.GetEdge(new_edge));
+            while (old_edge != old_edges.end() && edge_key(old_graph.GetEdge(*old_edge)) < new_key) {
+                ++old_edge;
+            }
+            if (old_edge != old_edges.end() && edge_key(old_graph.GetEdge(*old_edge)) == new_key) {
+                new_edge_ids[*old_edge++] = static_cast<PackedEdgeId>(new_edge);
+            } else {
+                added_edges.push_back(new_edge);
+            }
+        }
+    }
+}
+
+template <typename Weight>
+void Router<Weight>::RebuildRow(VertexId vertex_from) {
+    using QueueItem = std::pair<Weight, VertexId>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+    Weight* const row_weights = weights_.data() + GetCellIndex(vertex_from, 0);
+    PackedEdgeId* const row_prev_edges = prev_edges_.data() + GetCellIndex(vertex_from, 0);
+    std::fill(row_weights, row_weights + vertex_count_, NO_ROUTE);
+    std::fill(row_prev_edges, row_prev_edges + vertex_count_, NO_EDGE);
+    row_weights[vertex_from] = ZERO_WEIGHT;
+    queue.push({ZERO_WEIGHT, vertex_from});
+
+    while (!queue.empty()) {
+        const auto [weight, vertex] = queue.top();
+        queue.pop();
+        if (weight > row_weights[vertex]) {
+            continue;
+        }
+        for (const EdgeId edge_id : graph_.GetIncidentEdges(vertex)) {
+            const auto& edge = graph_.GetEdge(edge_id);
+            const Weight candidate_weight = weight + edge.weight;
+            if (candidate_weight < row_weights[edge.to]) {
+                row_weights[edge.to] = candidate_weight;
+                row_prev_edges[edge.to] = static_cast<PackedEdgeId>(edge_id);
+                queue.push({candidate_weight, edge.to});
+            }
+        }
+    }
+}
+
+template <typename Weight>
+void Router<Weight>::Update(const Graph& old_graph, thread_pool::ThreadPool& pool) {
+    if (old_graph.GetVertexCount() != vertex_count_ || graph_.GetVertexCount() != vertex_count_) {
+        throw std::invalid_argument("The route table can only be updated for the same vertices");
+    }
+    if (graph_.GetEdgeCount() >= NO_EDGE) {
+        throw std::length_error("Too many edges for the route table");
+    }
+    CheckNonNegativeWeights(graph_);
+    // A table mapped from a file is read-only, so take a copy before changing it.
+    if (weights_.empty()) {
+        const size_t cell_count = vertex_count_ * vertex_count_;
+        weights_.assign(weights_data_, weights_data_ + cell_count);
+        prev_edges_.assign(prev_edges_data_, prev_edges_data_ + cell_count);
+        weights_data_ = weights_.data();
+        prev_edges_data_ = prev_edges_.data();
+        file_ = mapped_file::MappedFile();
+    }
+
+    std::vector<PackedEdgeId> new_edge_ids;
+    std::vector<EdgeId> added_edges;
+    MatchEdges(old_graph, new_edge_ids, added_edges);
+
+    // Removing edges only makes routes longer, so a row that does not use any
+    // removed edge stays exact and just needs its edge ids renumbered.
+    pool.ParallelFor(vertex_count_, [this, &new_edge_ids](size_t vertex_from) {
+        PackedEdgeId* const row_prev_edges = prev_edges_.data() + GetCellIndex(vertex_from, 0);
+        const bool uses_removed_edge = std::any_of(row_prev_edges, row_prev_edges + vertex_count_,
+            [&new_edge_ids](PackedEdgeId edge_id) {
+                return edge_id != NO_EDGE && new_edge_ids[edge_id] == NO_EDGE;
+            });
+        if (uses_removed_edge) {
+            RebuildRow(vertex_from);
+            return;
+        }
+        for (VertexId vertex_to = 0; vertex_to < vertex_count_; ++vertex_to) {
+            if (row_prev_edges[vertex_to] != NO_EDGE) {
+                row_prev_edges[vertex_to] = new_edge_ids[row_prev_edges[vertex_to]];
+            }
+        }
+    });
+
+    // Every new shortest route splits into old routes joined at endpoints of
+    // added edges, so relaxing through those endpoints alone is enough.
+    std::vector<VertexId> endpoints;
+    for (const EdgeId edge_id : added_edges) {
+        const auto& edge = graph_.GetEdge(edge_id);
+        const size_t cell = GetCellIndex(edge.from, edge.to);
+        if (edge.weight < weights_[cell]) {
+            weights_[cell] = edge.weight;
+            prev_edges_[cell] = static_cast<PackedEdgeId>(edge_id);
+        }
+        endpoints.push_back(edge.from);
+        endpoints.push_back(edge.to);
+    }
+    std::sort(endpoints.begin(), endpoints.end());
+    endpoints.erase(std::unique(endpoints.begin(), endpoints.end()), endpoints.end());
+    for (const VertexId vertex_through : endpoints) {
+        pool.ParallelFor(vertex_count_, [this, vertex_through](size_t vertex_from) {
+            if (vertex_from != vertex_through) {
+                RelaxRowThroughVertex(vertex_from, vertex_through, 0, vertex_count_);
+            }
+        });
     }
 }
 
 template <typename Weight>
 std::optional<typename Router<Weight>::RouteInfo> Router<Weight>::BuildRoute(VertexId from,
-                                                                             VertexId to) const {
-    const auto& route_internal_data = routes_internal_data_.at(from).at(to);
-    if (!route_internal_data) {
+                                                                             VertexId to,
+                                                                             SearchStats* stats) const {
+    if (stats) {
+        *stats = SearchStats{};
+    }
+    if (from >= vertex_count_ || to >= vertex_count_) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    const Weight weight = weights_data_[GetCellIndex(from, to)];
+    if (weight == NO_ROUTE) {
         return std::nullopt;
     }
-    const Weight weight = route_internal_data->weight;
     std::vector<EdgeId> edges;
-    for (std::optional<EdgeId> edge_id = route_internal_data->prev_edge;
-         edge_id;
-         edge_id = routes_internal_data_[from][graph_.GetEdge(*edge_id).from]->prev_edge)
+    for (PackedEdgeId edge_id = prev_edges_data_[GetCellIndex(from, to)];
+         edge_id != NO_EDGE;
+         edge_id = prev_edges_data_[GetCellIndex(from, graph_.GetEdge(edge_id).from)])
     {
-        edges.push_back(*edge_id);
+        edges.push_back(edge_id);
     }
     std::reverse(edges.begin(), edges.end());
 
     return RouteInfo{weight, std::move(edges)};
 }
 
-}  // namespace graph
\ No newline at end of file
+}  // namespace graph
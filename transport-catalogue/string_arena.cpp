@@ -0,0 +1,34 @@
+#include "string_arena.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace string_arena {
+
+std::string_view StringArena::Add(std::string_view text) {
+    if (text.empty()) {
+        return {};
+    }
+    size_ += text.size();
+    if (text.size() > BLOCK_SIZE) {
+        auto block = std::make_unique<char[]>(text.size());
+        std::copy(text.begin(), text.end(), block.get());
+        const std::string_view result(block.get(), text.size());
+        blocks_.insert(blocks_.empty() ? blocks_.end() : std::prev(blocks_.end()), std::move(block));
+        return result;
+    }
+    if (BLOCK_SIZE - block_used_ < text.size()) {
+        blocks_.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+        block_used_ = 0;
+    }
+    char* const data = blocks_.back().get() + block_used_;
+    std::copy(text.begin(), text.end(), data);
+    block_used_ += text.size();
+    return {data, text.size()};
+}
+
+size_t StringArena::GetSize() const {
+    return size_;
+}
+
+} // namespace string_arena
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace string_arena {
+
+// Append-only storage for many short strings. Each string is copied into a
+// large shared block, so it costs its own length and no allocation of its own.
+// Blocks never move, so the returned views stay valid as long as the arena.
+class StringArena {
+public:
+    StringArena() = default;
+
+    StringArena(StringArena&&) = default;
+    StringArena& operator=(StringArena&&) = default;
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    std::string_view Add(std::string_view text);
+
+    // Bytes taken by the stored strings.
+    size_t GetSize() const;
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    // Bytes used in the last block of BLOCK_SIZE; strings longer than that get
+    // a block of their own, inserted before it.
+    size_t block_used_ = BLOCK_SIZE;
+    size_t size_ = 0;
+};
+
+} // namespace string_arena
@@ -0,0 +1,106 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace thread_pool {
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(thread_count - 1);
+    for (size_t i = 1; i < thread_count; ++i) {
+        workers_.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex_);
+        stopped_ = true;
+    }
+    task_ready_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::GetThreadCount() const {
+    return workers_.size() + 1;
+}
+
+void ThreadPool::ParallelFor(size_t task_count, const std::function<void(size_t)>& task) {
+    if (task_count == 0) {
+        return;
+    }
+    if (workers_.empty()) {
+        for (size_t index = 0; index < task_count; ++index) {
+            task(index);
+        }
+        return;
+    }
+
+    std::lock_guard call_lock(call_mutex_);
+    {
+        std::lock_guard lock(mutex_);
+        task_ = &task;
+        task_count_ = task_count;
+        next_index_ = 0;
+        exception_ = nullptr;
+        ++generation_;
+    }
+    task_ready_.notify_all();
+
+    RunTasks(task, task_count);
+
+    std::unique_lock lock(mutex_);
+    task_done_.wait(lock, [this] { return busy_workers_ == 0; });
+    task_ = nullptr;
+    if (exception_) {
+        std::rethrow_exception(std::exchange(exception_, nullptr));
+    }
+}
+
+void ThreadPool::WorkerLoop() {
+    size_t seen_generation = 0;
+    while (true) {
+        std::unique_lock lock(mutex_);
+        task_ready_.wait(lock, [this, seen_generation] {
+            return stopped_ || generation_ != seen_generation;
+        });
+        if (stopped_) {
+            return;
+        }
+        seen_generation = generation_;
+        if (!task_) {
+            continue;
+        }
+        const auto& task = *task_;
+        const size_t task_count = task_count_;
+        ++busy_workers_;
+        lock.unlock();
+
+        RunTasks(task, task_count);
+
+        lock.lock();
+        if (--busy_workers_ == 0) {
+            task_done_.notify_all();
+        }
+    }
+}
+
+void ThreadPool::RunTasks(const std::function<void(size_t)>& task, size_t task_count) {
+    for (size_t index = next_index_++; index < task_count; index = next_index_++) {
+        try {
+            task(index);
+        } catch (...) {
+            std::lock_guard lock(mutex_);
+            if (!exception_) {
+                exception_ = std::current_exception();
+            }
+        }
+    }
+}
+
+} // namespace thread_pool
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace thread_pool {
+
+class ThreadPool {
+public:
+    // thread_count includes the calling thread, so 1 means no extra threads
+    // and 0 means one thread per hardware core.
+    explicit ThreadPool(size_t thread_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t GetThreadCount() const;
+
+    // Calls task(index) for every index in [0, task_count) and blocks until all of them return.
+    // The first exception thrown by a task is rethrown here. The pool runs one
+    // batch of tasks at a time: a call from another thread waits until the
+    // running batch is done rather than sharing the workers with it. Must not
+    // be called from inside one of its own tasks.
+    void ParallelFor(size_t task_count, const std::function<void(size_t)>& task);
+
+private:
+    std::vector<std::thread> workers_;
+    // Held by the ParallelFor call whose tasks the workers are running.
+    std::mutex call_mutex_;
+    std::mutex mutex_;
+    std::condition_variable task_ready_;
+    std::condition_variable task_done_;
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t task_count_ = 0;
+    std::atomic<size_t> next_index_ = 0;
+    size_t generation_ = 0;
+    size_t busy_workers_ = 0;
+    std::exception_ptr exception_;
+    bool stopped_ = false;
+
+    void WorkerLoop();
+    void RunTasks(const std::function<void(size_t)>& task, size_t task_count);
+};
+
+} // namespace thread_pool
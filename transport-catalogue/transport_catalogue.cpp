@@ -1,110 +1,273 @@
 #include "transport_catalogue.h"
 
-#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
 #include <unordered_set>
 #include <utility>
 
 namespace transport_catalogue {
 
-size_t Stop2StopHasher::operator() (const std::pair<const Stop*, const Stop*>& stops_pair) const {
-    size_t stop1_hash = std::hash<const void*>{}(stops_pair.first);
-    size_t stop2_hash = std::hash<const void*>{}(stops_pair.second);
-    return stop1_hash ^ (stop2_hash << 1);
+uint64_t TransportCatalogue::GetStopPairKey(uint32_t stop_from_id, uint32_t stop_to_id) {
+    return static_cast<uint64_t>(stop_from_id) << 32 | stop_to_id;
 }
 
-void TransportCatalogue::AddStop(const std::string& stop_name
+void TransportCatalogue::CheckNotFrozen() const {
+    if (is_frozen_) {
+        throw std::logic_error("Cannot modify a frozen catalogue");
+    }
+}
+
+void TransportCatalogue::Freeze() {
+    if (is_frozen_) {
+        return;
+    }
+    stop_coordinates_.reserve(stops_.size());
+    for (const Stop& stop : stops_) {
+        stop_coordinates_.push_back(stop.coordinates);
+    }
+
+    // The bus list and the perfect hashes read the name maps, so they go first.
+    active_buses_ = GetAllBuses();
+    route_offsets_.reserve(buses_.size() + 1);
+    unique_stop_counts_.reserve(buses_.size());
+    std::vector<uint32_t> unique_stops;
+    for (const Bus& bus : buses_) {
+        route_offsets_.push_back(static_cast<uint32_t>(route_stop_ids_.size()));
+        for (const Stop* stop : bus.route_stops) {
+            route_stop_ids_.push_back(stop->id);
+        }
+        unique_stops.assign(route_stop_ids_.begin() + route_offsets_.back(), route_stop_ids_.end());
+        std::sort(unique_stops.begin(), unique_stops.end());
+        unique_stop_counts_.push_back(static_cast<uint32_t>(
+            std::unique(unique_stops.begin(), unique_stops.end()) - unique_stops.begin()));
+    }
+    route_offsets_.push_back(static_cast<uint32_t>(route_stop_ids_.size()));
+
+    stop_bus_offsets_.reserve(stops_.size() + 1);
+    for (const auto& buses : buses_at_stop_) {
+        stop_bus_offsets_.push_back(static_cast<uint32_t>(stop_bus_ids_.size()));
+        stop_bus_ids_.insert(stop_bus_ids_.end(), buses.begin(), buses.end());
+    }
+    stop_bus_offsets_.push_back(static_cast<uint32_t>(stop_bus_ids_.size()));
+
+    std::vector<std::pair<uint64_t, int>> distances(stop2stop_distances_.begin()
+                                                    , stop2stop_distances_.end());
+    std::sort(distances.begin(), distances.end());
+    distance_offsets_.assign(stops_.size() + 1, 0);
+    distance_stop_ids_.reserve(distances.size());
+    distance_values_.reserve(distances.size());
+    for (const auto& [key, distance] : distances) {
+        ++distance_offsets_[(key >> 32) + 1];
+        distance_stop_ids_.push_back(static_cast<uint32_t>(key));
+        distance_values_.push_back(distance);
+    }
+    for (size_t stop_id = 0; stop_id < stops_.size(); ++stop_id) {
+        distance_offsets_[stop_id + 1] += distance_offsets_[stop_id];
+    }
+
+    std::vector<std::string_view> names;
+    names.reserve(stops_.size());
+    for (const Stop& stop : stops_) {
+        names.push_back(stop.name);
+    }
+    stop_name_hash_ = perfect_hash::MinimalPerfectHash(names);
+    names.clear();
+    for (const Bus* bus : active_buses_) {
+        names.push_back(bus->name);
+    }
+    bus_name_hash_ = perfect_hash::MinimalPerfectHash(names);
+
+    std::unordered_map<std::string_view, uint32_t>().swap(stopname_to_id_);
+    std::unordered_map<std::string_view, uint32_t>().swap(busname_to_id_);
+    std::vector<std::vector<uint32_t>>().swap(buses_at_stop_);
+    std::unordered_map<uint64_t, int>().swap(stop2stop_distances_);
+    is_frozen_ = true;
+}
+
+bool TransportCatalogue::IsFrozen() const {
+    return is_frozen_;
+}
+
+void TransportCatalogue::AddStop(const std::string_view stop_name
                                  , const geo::Coordinates& coordinates) {
-    stops_.push_back({stop_name, coordinates});
-    stopname_to_stop_[stops_.back().name] = &stops_.back();
+    CheckNotFrozen();
+    if (const auto old_stop = stopname_to_id_.find(stop_name); old_stop != stopname_to_id_.end()) {
+        stops_[old_stop->second].coordinates = coordinates;
+        return;
+    }
+    const auto stop_id = static_cast<uint32_t>(stops_.size());
+    stops_.push_back({names_.Add(stop_name), coordinates, stop_id});
+    stopname_to_id_[stops_.back().name] = stop_id;
+    buses_at_stop_.emplace_back();
 }
 
 void TransportCatalogue::SetStop2StopDistance(const std::string_view stop_from
                                             , const std::string_view stop_to, int distance){
-        auto stop_presence = stopname_to_stop_.find(stop_from);
-        auto to_stop_presence = stopname_to_stop_.find(stop_to);
-        if (stop_presence != stopname_to_stop_.end()
-            && to_stop_presence != stopname_to_stop_.end()) {
-            auto key = std::pair(stop_presence->second
-                                 , to_stop_presence->second);
-            stop2stop_distances_.insert({key, distance});
+        CheckNotFrozen();
+        auto stop_presence = stopname_to_id_.find(stop_from);
+        auto to_stop_presence = stopname_to_id_.find(stop_to);
+        if (stop_presence != stopname_to_id_.end()
+            && to_stop_presence != stopname_to_id_.end()) {
+            stop2stop_distances_.insert_or_assign(
+                GetStopPairKey(stop_presence->second, to_stop_presence->second), distance);
         }
 }
 
-void TransportCatalogue::AddBus(const std::string& bus_id
+void TransportCatalogue::AddBus(const std::string_view bus_id
                                 , const std::vector<std::string_view>& route_stops
-                                , bool is_roundtrip) {
+                                , bool is_roundtrip
+                                , std::vector<double> departure_times) {
+    CheckNotFrozen();
+    // A replaced bus passes its stored name on to the new one.
+    const auto old_bus = busname_to_id_.find(bus_id);
+    const std::string_view bus_name = old_bus != busname_to_id_.end()
+                                      ? buses_[old_bus->second].name
+                                      : names_.Add(bus_id);
+    RemoveBus(bus_id);
+    const auto new_bus_id = static_cast<uint32_t>(buses_.size());
     std::vector<const Stop*> result;
     result.reserve(route_stops.size());
-    buses_.push_back({bus_id, result, is_roundtrip});
 
     for (const auto& stop : route_stops) {
-        auto stop_presence = stopname_to_stop_.find(stop);
-        if (stop_presence == stopname_to_stop_.end()) {
+        auto stop_presence = stopname_to_id_.find(stop);
+        if (stop_presence == stopname_to_id_.end()) {
             continue;
         }
-        result.push_back(stop_presence->second);
-        buses_at_stop_[stop_presence->first].insert(buses_.back().name);
+        result.push_back(&stops_[stop_presence->second]);
+        // The new bus has the largest id, so the list stays sorted and a repeated
+        // visit can only find it at the back.
+        auto& buses = buses_at_stop_[stop_presence->second];
+        if (buses.empty() || buses.back() != new_bus_id) {
+            buses.push_back(new_bus_id);
+        }
     }
 
-    buses_.back().route_stops = std::move(result);
-    busname_to_bus_[buses_.back().name] = &buses_.back();
+    buses_.push_back({bus_name, std::move(result), is_roundtrip, std::move(departure_times), new_bus_id});
+    busname_to_id_[bus_name] = new_bus_id;
 }
 
-const Stop* TransportCatalogue::GetStop(const std::string_view stop_name) const {
-    auto stop_presence = stopname_to_stop_.find(stop_name);
-    if (stop_presence == stopname_to_stop_.end()) {
-        return nullptr;
+void TransportCatalogue::RemoveBus(const std::string_view bus_id) {
+    CheckNotFrozen();
+    auto bus_presence = busname_to_id_.find(bus_id);
+    if (bus_presence == busname_to_id_.end()) {
+        return;
+    }
+    const Bus& bus = buses_[bus_presence->second];
+    for (const Stop* stop : bus.route_stops) {
+        auto& buses = buses_at_stop_[stop->id];
+        if (const auto position = std::lower_bound(buses.begin(), buses.end(), bus.id);
+            position != buses.end() && *position == bus.id) {
+            buses.erase(position);
+        }
+    }
+    busname_to_id_.erase(bus_presence);
+}
+
+std::optional<uint32_t> TransportCatalogue::FindStopId(const std::string_view stop_name) const {
+    if (is_frozen_) {
+        if (stops_.empty()) {
+            return std::nullopt;
+        }
+        const uint32_t stop_id = stop_name_hash_.GetIndex(stop_name);
+        if (stops_[stop_id].name != stop_name) {
+            return std::nullopt;
+        }
+        return stop_id;
+    }
+    auto stop_presence = stopname_to_id_.find(stop_name);
+    if (stop_presence == stopname_to_id_.end()) {
+        return std::nullopt;
     }
     return stop_presence->second;
 }
 
-const Bus* TransportCatalogue::GetBus(const std::string_view bus_id) const {
-    auto bus_presence = busname_to_bus_.find(bus_id);
-    if (bus_presence == busname_to_bus_.end()) {
-        return nullptr;
+std::optional<uint32_t> TransportCatalogue::FindBusId(const std::string_view bus_id) const {
+    if (is_frozen_) {
+        if (active_buses_.empty()) {
+            return std::nullopt;
+        }
+        const Bus* bus = active_buses_[bus_name_hash_.GetIndex(bus_id)];
+        if (bus->name != bus_id) {
+            return std::nullopt;
+        }
+        return bus->id;
+    }
+    auto bus_presence = busname_to_id_.find(bus_id);
+    if (bus_presence == busname_to_id_.end()) {
+        return std::nullopt;
     }
     return bus_presence->second;
 }
 
+const Stop* TransportCatalogue::GetStop(const std::string_view stop_name) const {
+    const auto stop_id = FindStopId(stop_name);
+    return stop_id ? &stops_[*stop_id] : nullptr;
+}
+
+const Bus* TransportCatalogue::GetBus(const std::string_view bus_id) const {
+    const auto found_bus_id = FindBusId(bus_id);
+    return found_bus_id ? &buses_[*found_bus_id] : nullptr;
+}
+
+const Stop& TransportCatalogue::GetStopById(uint32_t id) const {
+    return stops_.at(id);
+}
+
+const Bus& TransportCatalogue::GetBusById(uint32_t id) const {
+    return buses_.at(id);
+}
+
 const BusRouteInfo TransportCatalogue::GetBusInfo(const std::string_view bus_id) const {
-    BusRouteInfo result;
-    auto bus_ptr = GetBus(bus_id);
+    const Bus* bus_ptr = GetBus(bus_id);
+    if (!bus_ptr) {
+        return {};
+    }
+    if (is_frozen_) {
+        const uint32_t route_offset = route_offsets_[bus_ptr->id];
+        return ComputeBusInfo(route_stop_ids_.data() + route_offset
+                              , route_offsets_[bus_ptr->id + 1] - route_offset
+                              , bus_ptr->is_roundtrip
+                              , static_cast<int>(unique_stop_counts_[bus_ptr->id]));
+    }
+    std::vector<uint32_t> stop_ids;
+    stop_ids.reserve(bus_ptr->route_stops.size());
+    for (const Stop* stop : bus_ptr->route_stops) {
+        stop_ids.push_back(stop->id);
+    }
+    const std::unordered_set<uint32_t> unique_stops(stop_ids.begin(), stop_ids.end());
+    return ComputeBusInfo(stop_ids.data()
+                          , stop_ids.size()
+                          , bus_ptr->is_roundtrip
+                          , static_cast<int>(unique_stops.size()));
+}
 
-    if (!GetBus(bus_id)) {
+BusRouteInfo TransportCatalogue::ComputeBusInfo(const uint32_t* stop_ids
+                                                , size_t stop_count
+                                                , bool is_roundtrip
+                                                , int unique_stops) const {
+    BusRouteInfo result;
+    result.unique_stops = unique_stops;
+    result.stops_count = static_cast<int>(stop_count);
+    if (stop_count == 0) {
         return result;
     }
+    const auto get_coordinates = [this](uint32_t stop_id) -> const geo::Coordinates& {
+        return is_frozen_ ? stop_coordinates_[stop_id] : stops_[stop_id].coordinates;
+    };
 
     double route_geo_length = 0.0;
-    result.stops_count = static_cast<int>(bus_ptr->route_stops.size());
-    std::unordered_set<const Stop*> unique_stops(bus_ptr->route_stops.begin()
-                                                  , bus_ptr->route_stops.end());
-    result.unique_stops = static_cast<int>(unique_stops.size());
-
-    if(!bus_ptr->is_roundtrip) {
-        
-        for (size_t i = 1; i < static_cast<size_t>(result.stops_count); ++i) {
-            result.route_length += GetRealDistance(bus_ptr->route_stops[i-1]
-                                                       , bus_ptr->route_stops[i]);
-            route_geo_length += ComputeGeoDistance(bus_ptr->route_stops[i]->coordinates
-                                                , bus_ptr->route_stops[i-1]->coordinates);
-        }
-
-        for (size_t i = static_cast<size_t>(result.stops_count) - 1; i > 0; --i) {
-            result.route_length += GetRealDistance(bus_ptr->route_stops[i]
-                                                       , bus_ptr->route_stops[i-1]);
-            route_geo_length += ComputeGeoDistance(bus_ptr->route_stops[i]->coordinates
-                                                , bus_ptr->route_stops[i-1]->coordinates);
-        }
-        
-        result.stops_count = static_cast<int>(bus_ptr->route_stops.size()) * 2 - 1;
-    } else {
-
-        for (size_t i = 1; i < static_cast<size_t>(result.stops_count); ++i) {
-            result.route_length += GetRealDistance(bus_ptr->route_stops[i-1]
-                                                    , bus_ptr->route_stops[i]);
-            route_geo_length += ComputeGeoDistance(bus_ptr->route_stops[i]->coordinates
-                                                , bus_ptr->route_stops[i-1]->coordinates);
+    for (size_t i = 1; i < stop_count; ++i) {
+        result.route_length += GetRealDistanceById(stop_ids[i - 1], stop_ids[i]);
+        route_geo_length += ComputeGeoDistance(get_coordinates(stop_ids[i])
+                                               , get_coordinates(stop_ids[i - 1]));
+    }
+    if (!is_roundtrip) {
+        for (size_t i = stop_count - 1; i > 0; --i) {
+            result.route_length += GetRealDistanceById(stop_ids[i], stop_ids[i - 1]);
+            route_geo_length += ComputeGeoDistance(get_coordinates(stop_ids[i])
+                                                   , get_coordinates(stop_ids[i - 1]));
         }
+        result.stops_count = static_cast<int>(stop_count) * 2 - 1;
     }
 
     result.curvature = result.route_length / route_geo_length;
@@ -112,34 +275,70 @@ const BusRouteInfo TransportCatalogue::GetBusInfo(const std::string_view bus_id)
     return result;
 }
 
-const std::unordered_set<std::string_view>& TransportCatalogue::GetStopInfo(
-                                        const std::string_view stop_name) const {
-    static const std::unordered_set<std::string_view> dummy;
-    auto result = buses_at_stop_.find(stop_name);
-    if (result == buses_at_stop_.end()) {
-        return dummy;
+std::vector<std::string_view> TransportCatalogue::GetStopInfo(const std::string_view stop_name) const {
+    std::vector<std::string_view> result;
+    const auto found_stop_id = FindStopId(stop_name);
+    if (!found_stop_id) {
+        return result;
     }
-    return result->second;
+    const uint32_t stop_id = *found_stop_id;
+    const uint32_t* const first = is_frozen_ ? stop_bus_ids_.data() + stop_bus_offsets_[stop_id]
+                                             : buses_at_stop_[stop_id].data();
+    const uint32_t* const last = is_frozen_ ? stop_bus_ids_.data() + stop_bus_offsets_[stop_id + 1]
+                                            : first + buses_at_stop_[stop_id].size();
+    result.reserve(last - first);
+    for (const uint32_t* bus_id = first; bus_id != last; ++bus_id) {
+        result.push_back(buses_[*bus_id].name);
+    }
+    return result;
 }
 
-const std::unordered_map<std::string_view, const Bus*>& TransportCatalogue::GetAllBuses() const {
-    return busname_to_bus_;
+std::vector<const Bus*> TransportCatalogue::GetAllBuses() const {
+    if (is_frozen_) {
+        return active_buses_;
+    }
+    std::vector<const Bus*> result;
+    result.reserve(busname_to_id_.size());
+    for (const Bus& bus : buses_) {
+        if (const auto bus_presence = busname_to_id_.find(bus.name);
+            bus_presence != busname_to_id_.end() && bus_presence->second == bus.id) {
+            result.push_back(&bus);
+        }
+    }
+    return result;
 }
 
-const std::unordered_map<std::string_view, const Stop*>& TransportCatalogue::GetAllStops() const {
-    return stopname_to_stop_;
+const std::deque<Stop>& TransportCatalogue::GetAllStops() const {
+    return stops_;
 }
 
-int TransportCatalogue::GetRealDistance(const Stop* stop_from, const Stop* stop_to) const {
-    auto it_forw = stop2stop_distances_.find({stop_from, stop_to});
-    if (it_forw != stop2stop_distances_.end()) {
-        return it_forw->second;
+std::optional<int> TransportCatalogue::FindDistance(uint32_t stop_from_id, uint32_t stop_to_id) const {
+    if (is_frozen_) {
+        const auto first = distance_stop_ids_.begin() + distance_offsets_[stop_from_id];
+        const auto last = distance_stop_ids_.begin() + distance_offsets_[stop_from_id + 1];
+        const auto position = std::lower_bound(first, last, stop_to_id);
+        if (position == last || *position != stop_to_id) {
+            return std::nullopt;
+        }
+        return distance_values_[position - distance_stop_ids_.begin()];
     }
-    auto it_backw = stop2stop_distances_.find({stop_to, stop_from});
-    if (it_backw != stop2stop_distances_.end()) {
-        return it_backw->second;
+    const auto distance = stop2stop_distances_.find(GetStopPairKey(stop_from_id, stop_to_id));
+    if (distance == stop2stop_distances_.end()) {
+        return std::nullopt;
+    }
+    return distance->second;
+}
+
+int TransportCatalogue::GetRealDistanceById(uint32_t stop_from_id, uint32_t stop_to_id) const {
+    // A distance set in one direction only holds for the other one as well.
+    if (const auto distance = FindDistance(stop_from_id, stop_to_id)) {
+        return *distance;
     }
-    return 0;
+    return FindDistance(stop_to_id, stop_from_id).value_or(0);
+}
+
+int TransportCatalogue::GetRealDistance(const Stop* stop_from, const Stop* stop_to) const {
+    return GetRealDistanceById(stop_from->id, stop_to->id);
 }
 
-} // namespace transport_catalogue
\ No newline at end of file
+} // namespace transport_catalogue
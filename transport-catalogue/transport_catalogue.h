@@ -2,54 +2,108 @@
 
 #include "domain.h"
 #include "geo.h"
+#include "perfect_hash.h"
+#include "string_arena.h"
 
+#include <cstdint>
 #include <deque>
-#include <string>
+#include <optional>
+#include <string_view>
 #include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
 namespace transport_catalogue {
 
-struct Stop2StopHasher {
-    size_t operator() (const std::pair<const Stop*, const Stop*>& stops_pair) const;
-};
-
 class TransportCatalogue {
 public:
     TransportCatalogue() = default;
 
-    void AddStop(const std::string& stop_name, const geo::Coordinates& coordinates);
+    // Copies the catalogue into flat arrays indexed by stop and bus id that
+    // all queries read from afterwards, and replaces the name maps with
+    // minimal perfect hashes. Changing a frozen catalogue throws std::logic_error.
+    void Freeze();
+    bool IsFrozen() const;
+
+    // A stop added again under the same name keeps its id and takes the new coordinates.
+    void AddStop(const std::string_view stop_name, const geo::Coordinates& coordinates);
 
     void SetStop2StopDistance(const std::string_view stop_from, const std::string_view stop_to, int distance);
 
-    void AddBus(const std::string& bus_id
+    void AddBus(const std::string_view bus_id
                 , const std::vector<std::string_view>& route_stops
-                , bool is_roundtrip);
+                , bool is_roundtrip
+                , std::vector<double> departure_times = {});
+
+    // Drops the bus from all lookups. Its id stays reserved, so GetBusById keeps working.
+    void RemoveBus(const std::string_view bus_id);
 
     const Stop* GetStop(const std::string_view stop_name) const;
 
     const Bus* GetBus(const std::string_view bus_id) const;
 
+    const Stop& GetStopById(uint32_t id) const;
+
+    const Bus& GetBusById(uint32_t id) const;
+
     const BusRouteInfo GetBusInfo(const std::string_view bus_id) const;
 
-    const std::unordered_set<std::string_view>& GetStopInfo(const std::string_view stop_name) const;
+    // Names of the buses through the stop in order of bus id.
+    std::vector<std::string_view> GetStopInfo(const std::string_view stop_name) const;
 
-    const std::unordered_map<std::string_view, const Bus*>& GetAllBuses() const;
+    // Buses that were not removed, in order of id.
+    std::vector<const Bus*> GetAllBuses() const;
 
-    const std::unordered_map<std::string_view, const Stop*>& GetAllStops() const;
+    // All stops in order of id.
+    const std::deque<Stop>& GetAllStops() const;
 
     int GetRealDistance(const Stop* stop_from, const Stop* stop_to) const;
 
 private:
+    static uint64_t GetStopPairKey(uint32_t stop_from_id, uint32_t stop_to_id);
+
+    void CheckNotFrozen() const;
+    std::optional<uint32_t> FindStopId(const std::string_view stop_name) const;
+    std::optional<uint32_t> FindBusId(const std::string_view bus_id) const;
+    // Road distance set from one stop to the other, if any.
+    std::optional<int> FindDistance(uint32_t stop_from_id, uint32_t stop_to_id) const;
+    int GetRealDistanceById(uint32_t stop_from_id, uint32_t stop_to_id) const;
+    BusRouteInfo ComputeBusInfo(const uint32_t* stop_ids
+                                , size_t stop_count
+                                , bool is_roundtrip
+                                , int unique_stops) const;
+
+    // Stop and bus names, each stored once.
+    string_arena::StringArena names_;
     std::deque<Stop> stops_;
     std::deque<Bus> buses_;
-    std::unordered_map<std::string_view, const Stop*> stopname_to_stop_;
-    std::unordered_map<std::string_view, const Bus*> busname_to_bus_;
-    std::unordered_map<std::string_view, std::unordered_set<std::string_view>> buses_at_stop_;
-    std::unordered_map<std::pair<const Stop*, const Stop*>, int, Stop2StopHasher> stop2stop_distances_;
- 
+    std::unordered_map<std::string_view, uint32_t> stopname_to_id_;
+    std::unordered_map<std::string_view, uint32_t> busname_to_id_;
+    // Ids of the buses through each stop, indexed by stop id and sorted.
+    std::vector<std::vector<uint32_t>> buses_at_stop_;
+    // Keyed by the ids of both stops, see GetStopPairKey.
+    std::unordered_map<uint64_t, int> stop2stop_distances_;
+
+    // Built by Freeze, which drops the name maps, buses_at_stop_ and
+    // stop2stop_distances_.
+    bool is_frozen_ = false;
+    // Index stop ids and positions in active_buses_ by name.
+    perfect_hash::MinimalPerfectHash stop_name_hash_;
+    perfect_hash::MinimalPerfectHash bus_name_hash_;
+    std::vector<geo::Coordinates> stop_coordinates_;
+    // The stops of bus b are route_stop_ids_[route_offsets_[b]] up to
+    // route_stop_ids_[route_offsets_[b + 1]].
+    std::vector<uint32_t> route_offsets_;
+    std::vector<uint32_t> route_stop_ids_;
+    std::vector<uint32_t> unique_stop_counts_;
+    // The sorted ids of the buses through stop s, laid out the same way.
+    std::vector<uint32_t> stop_bus_offsets_;
+    std::vector<uint32_t> stop_bus_ids_;
+    // Road distances from stop s, sorted by the id of the stop they lead to.
+    std::vector<uint32_t> distance_offsets_;
+    std::vector<uint32_t> distance_stop_ids_;
+    std::vector<int> distance_values_;
+    std::vector<const Bus*> active_buses_;
 };
 
-} // namespace transport_catalogue
\ No newline at end of file
+} // namespace transport_catalogue
@@ -1,15 +1,116 @@
 #include "transport_router.h"
 
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
 namespace transport_router {
 
+namespace {
+
+// Fixed-point weights count thousandths of a minute.
+constexpr double FIXED_POINT_SCALE = 1000.0;
+// Minutes taken off every A* lower bound, so that it stays below the travel
+// time where rounding exceeds the relative margin, as between stops a few
+// millimetres apart.
+constexpr double LOWER_BOUND_MARGIN = 1e-9;
+
+template <typename Weight>
+Weight ConvertWeight(double weight) {
+    if constexpr (std::is_floating_point_v<Weight>) {
+        return static_cast<Weight>(weight);
+    } else {
+        const double scaled_weight = std::round(weight * FIXED_POINT_SCALE);
+        // The maximum marks missing routes in the table.
+        if (scaled_weight >= static_cast<double>(std::numeric_limits<Weight>::max())) {
+            throw std::out_of_range("Edge weight is too large for fixed-point routing");
+        }
+        return static_cast<Weight>(scaled_weight);
+    }
+}
+
+// Copy of a frozen graph with converted weights. Adding the edges in id order
+// keeps every edge id, so routes found in the copy index the original.
+template <typename Weight>
+graph::DirectedWeightedGraph<Weight> ConvertGraph(const graph::DirectedWeightedGraph<double>& graph) {
+    std::vector<graph::Edge<Weight>> edges;
+    edges.reserve(graph.GetEdgeCount());
+    for (graph::EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+        const auto& edge = graph.GetEdge(edge_id);
+        edges.push_back({edge.name_id
+                         , edge.span_count
+                         , edge.from
+                         , edge.to
+                         , ConvertWeight<Weight>(edge.weight)});
+    }
+    graph::DirectedWeightedGraph<Weight> result(graph.GetVertexCount());
+    result.AddEdges(edges);
+    result.Freeze();
+    return result;
+}
+
+} // namespace
+
+RouteView::RouteView(const graph::DirectedWeightedGraph<double>& graph
+                     , double total_time
+                     , std::shared_ptr<const std::vector<graph::EdgeId>> edge_ids)
+    : graph_(&graph)
+    , total_time_(total_time)
+    , edge_ids_(std::move(edge_ids)) {
+}
+
+RouteView::RouteView(double total_time
+                     , std::shared_ptr<const std::vector<graph::Edge<double>>> edges)
+    : total_time_(total_time)
+    , edges_(std::move(edges)) {
+}
+
+double RouteView::GetTotalTime() const {
+    return total_time_;
+}
+
+size_t RouteView::GetEdgeCount() const {
+    return edges_ ? edges_->size() : edge_ids_->size();
+}
+
+const graph::Edge<double>& RouteView::GetEdge(size_t index) const {
+    return edges_ ? (*edges_)[index] : graph_->GetEdge((*edge_ids_)[index]);
+}
+
+RouteView::Iterator RouteView::begin() const {
+    return Iterator(*this, 0);
+}
+
+RouteView::Iterator RouteView::end() const {
+    return Iterator(*this, GetEdgeCount());
+}
+
+size_t VertexPairHasher::operator() (const std::pair<graph::VertexId, graph::VertexId>& vertices) const {
+    return std::hash<graph::VertexId>{}(vertices.first) * 37 + std::hash<graph::VertexId>{}(vertices.second);
+}
+
 void TransportRouter::FillVertexes(const transport_catalogue::TransportCatalogue& catalogue) {
     const auto& all_stops = catalogue.GetAllStops();
     graph_ = graph::DirectedWeightedGraph<double>(all_stops.size() * 2);
+    stop_to_vertex_ids_.clear();
+    vertex_coordinates_.clear();
+    vertex_coordinates_.reserve(all_stops.size() * 2);
+    vertex_stop_names_.clear();
+    vertex_stop_names_.reserve(all_stops.size() * 2);
     graph::VertexId vertex_id = 0;
 
-    for (const auto& [stop_name, stop_ptr] : all_stops) {
-        stop_to_vertex_ids_[stop_ptr->name] = vertex_id;
-        graph_.AddEdge({stop_ptr->name
+    for (const transport_catalogue::Stop& stop : all_stops) {
+        stop_to_vertex_ids_[stop.name] = vertex_id;
+        vertex_coordinates_.push_back(stop.coordinates);
+        vertex_coordinates_.push_back(stop.coordinates);
+        vertex_stop_names_.push_back(stop.name);
+        vertex_stop_names_.push_back(stop.name);
+        graph_.AddEdge({stop.id
                     , 0
                     , vertex_id++
                     , vertex_id++
@@ -17,69 +118,469 @@ void TransportRouter::FillVertexes(const transport_catalogue::TransportCatalogue
     }
 }
 
-void TransportRouter::FillEdges(const transport_catalogue::TransportCatalogue& catalogue) {
-    const auto& all_buses = catalogue.GetAllBuses();
-
-    for (const auto& [bus_name, bus_info] : all_buses) {
-        const auto& stops = bus_info->route_stops;
-        size_t stops_count = stops.size();
-
-        for (size_t i = 0; i < stops_count; ++i) {
-            int dist_sum = 0;
-            int dist_sum_inverse = 0;
-
-            for (size_t j = i + 1; j < stops_count; ++j) {
-                const transport_catalogue::Stop* stop_from = stops[i];
-                const transport_catalogue::Stop* stop_to = stops[j];
-
-                dist_sum += catalogue.GetRealDistance(stops[j - 1], stops[j]);
-                dist_sum_inverse += catalogue.GetRealDistance(stops[j], stops[j - 1]);
-
-                graph_.AddEdge({ bus_info->name,
-                                j - i,
-                                stop_to_vertex_ids_.at(stop_from->name) + 1,
-                                stop_to_vertex_ids_.at(stop_to->name),
-                                static_cast<double>(dist_sum)
-                                    / routing_settings_.bus_velocity });
-
-                if (!bus_info->is_roundtrip) {
-                    graph_.AddEdge({ bus_info->name,
-                                    j - i,
-                                    stop_to_vertex_ids_.at(stop_to->name) + 1,
-                                    stop_to_vertex_ids_.at(stop_from->name),
-                                    static_cast<double>(dist_sum_inverse)
-                                        / routing_settings_.bus_velocity });
-                }
+size_t TransportRouter::CountBusEdges(const transport_catalogue::Bus& bus) {
+    const size_t stops_count = bus.route_stops.size();
+    const size_t stop_pairs = stops_count * (stops_count - (stops_count > 0 ? 1 : 0)) / 2;
+    return bus.is_roundtrip ? stop_pairs : stop_pairs * 2;
+}
+
+void TransportRouter::FillBusEdges(const transport_catalogue::TransportCatalogue& catalogue
+                                   , const transport_catalogue::Bus& bus
+                                   , graph::Edge<double>* edges) const {
+    const auto& stops = bus.route_stops;
+    const size_t stops_count = stops.size();
+    // Vertices and road distances are looked up once per stop rather than once
+    // per edge; distances from the first stop give every edge by subtraction.
+    std::vector<graph::VertexId> vertices(stops_count);
+    std::vector<int64_t> distances(stops_count, 0);
+    std::vector<int64_t> distances_inverse(stops_count, 0);
+    for (size_t i = 0; i < stops_count; ++i) {
+        vertices[i] = stop_to_vertex_ids_.at(stops[i]->name);
+        if (i > 0) {
+            distances[i] = distances[i - 1] + catalogue.GetRealDistance(stops[i - 1], stops[i]);
+            distances_inverse[i] = distances_inverse[i - 1] + catalogue.GetRealDistance(stops[i], stops[i - 1]);
+        }
+    }
+
+    for (size_t i = 0; i < stops_count; ++i) {
+        for (size_t j = i + 1; j < stops_count; ++j) {
+            *edges++ = { bus.id,
+                         static_cast<uint32_t>(j - i),
+                         vertices[i] + 1,
+                         vertices[j],
+                         static_cast<double>(distances[j] - distances[i])
+                             / routing_settings_.bus_velocity };
+
+            if (!bus.is_roundtrip) {
+                *edges++ = { bus.id,
+                             static_cast<uint32_t>(j - i),
+                             vertices[j] + 1,
+                             vertices[i],
+                             static_cast<double>(distances_inverse[j] - distances_inverse[i])
+                                 / routing_settings_.bus_velocity };
             }
         }
     }
 }
 
+void TransportRouter::FillEdges(const transport_catalogue::TransportCatalogue& catalogue) {
+    // Buses come in id order, so edge ids depend on the catalogue alone and
+    // not on which thread builds which bus.
+    const std::vector<const transport_catalogue::Bus*> buses = catalogue.GetAllBuses();
+
+    // Each bus fills its own block of one array sized up front, so threads
+    // never share a vector and the merge is a plain pass in block order.
+    std::vector<size_t> edge_offsets(buses.size() + 1, 0);
+    for (size_t bus_index = 0; bus_index < buses.size(); ++bus_index) {
+        edge_offsets[bus_index + 1] = edge_offsets[bus_index] + CountBusEdges(*buses[bus_index]);
+    }
+    std::vector<graph::Edge<double>> edges(edge_offsets.back());
+    thread_pool_->ParallelFor(buses.size(), [&](size_t bus_index) {
+        FillBusEdges(catalogue, *buses[bus_index], edges.data() + edge_offsets[bus_index]);
+    });
+    graph_.AddEdges(edges);
+}
+
+void TransportRouter::ComputeMinTimePerMeter() {
+    std::optional<double> min_time_per_meter;
+    for (graph::EdgeId edge_id = 0; edge_id < graph_.GetEdgeCount(); ++edge_id) {
+        const auto& edge = graph_.GetEdge(edge_id);
+        const double distance = geo::ComputeHaversineDistance(vertex_coordinates_[edge.from]
+                                                              , vertex_coordinates_[edge.to]);
+        if (distance > 0.0 && (!min_time_per_meter || edge.weight / distance < *min_time_per_meter)) {
+            min_time_per_meter = edge.weight / distance;
+        }
+    }
+    // Leaves room for rounding so the bound never overestimates.
+    const double rounding_margin = 1.0 - 1e-9;
+    min_time_per_meter_ = min_time_per_meter.value_or(0.0) * rounding_margin;
+}
+
+double TransportRouter::GetTimeLowerBound(graph::VertexId from, graph::VertexId to) const {
+    const double bound = min_time_per_meter_ * geo::ComputeHaversineDistance(vertex_coordinates_[from]
+                                                                             , vertex_coordinates_[to]);
+    return (std::isfinite(bound) ? bound : 0.0) - LOWER_BOUND_MARGIN;
+}
+
+template <typename Weight>
+std::unique_ptr<graph::Router<Weight>> TransportRouter::BuildAllPairsRouter(
+                                            const graph::DirectedWeightedGraph<Weight>& graph) const {
+    if (routing_settings_.cache_file.empty()) {
+        return std::make_unique<graph::Router<Weight>>(graph, *thread_pool_);
+    }
+    if (auto router = graph::Router<Weight>::LoadFromFile(graph, routing_settings_.cache_file)) {
+        return router;
+    }
+    auto router = std::make_unique<graph::Router<Weight>>(graph, *thread_pool_);
+    router->SaveToFile(routing_settings_.cache_file);
+    return router;
+}
+
+void TransportRouter::BuildAllPairsRouter() {
+    switch (routing_settings_.weight_type) {
+    case WeightType::DOUBLE:
+        router_ = BuildAllPairsRouter(graph_);
+        break;
+    case WeightType::FLOAT:
+        float_graph_ = ConvertGraph<float>(graph_);
+        router_ = BuildAllPairsRouter(float_graph_);
+        break;
+    case WeightType::FIXED_POINT:
+        fixed_point_graph_ = ConvertGraph<uint32_t>(graph_);
+        router_ = BuildAllPairsRouter(fixed_point_graph_);
+        break;
+    }
+}
+
+template <typename Weight>
+void TransportRouter::UpdateAllPairsRouter(const graph::DirectedWeightedGraph<Weight>& old_graph) {
+    auto& router = std::get<std::unique_ptr<graph::Router<Weight>>>(router_);
+    router->Update(old_graph, *thread_pool_);
+    if (!routing_settings_.cache_file.empty()) {
+        router->SaveToFile(routing_settings_.cache_file);
+    }
+}
+
+std::vector<graph::VertexId> TransportRouter::GetWaitVertices() const {
+    std::vector<graph::VertexId> wait_vertices;
+    wait_vertices.reserve(stop_to_vertex_ids_.size());
+    for (const auto& [stop_name, vertex_id] : stop_to_vertex_ids_) {
+        wait_vertices.push_back(vertex_id);
+    }
+    std::sort(wait_vertices.begin(), wait_vertices.end());
+    return wait_vertices;
+}
+
+std::unique_ptr<graph::ReducedRouter<double>> TransportRouter::BuildStopTableRouter() const {
+    // Routes only start and end at the wait vertex of a stop; the boarding vertex
+    // is entered by its wait edge alone.
+    return std::make_unique<graph::ReducedRouter<double>>(graph_
+                                                        , GetWaitVertices()
+                                                        , *thread_pool_);
+}
+
+void TransportRouter::BuildHubLabels() {
+    hub_labels_.reset();
+    if (!routing_settings_.hub_labels) {
+        return;
+    }
+    const auto wait_vertices = GetWaitVertices();
+    if (!routing_settings_.hub_label_file.empty()) {
+        hub_labels_ = graph::HubLabelIndex<double>::LoadFromFile(graph_
+                                                                , wait_vertices
+                                                                , routing_settings_.hub_label_file);
+    }
+    if (!hub_labels_) {
+        hub_labels_ = std::make_unique<graph::HubLabelIndex<double>>(graph_, wait_vertices);
+        if (!routing_settings_.hub_label_file.empty()) {
+            hub_labels_->SaveToFile(routing_settings_.hub_label_file);
+        }
+    }
+}
+
+void TransportRouter::BuildBusLineRouters(const transport_catalogue::TransportCatalogue& catalogue) {
+    bus_lines_ = std::make_unique<BusLines>(catalogue, stop_to_vertex_ids_);
+    raptor_router_ = std::make_unique<RaptorRouter>(*bus_lines_
+                                    , static_cast<double>(routing_settings_.bus_wait_time)
+                                    , routing_settings_.bus_velocity);
+    timetable_router_ = std::make_unique<ConnectionScanRouter>(*bus_lines_, routing_settings_.bus_velocity);
+}
+
 void TransportRouter::BuildGraph(
                     const transport_catalogue::TransportCatalogue& catalogue) {
+    if (!thread_pool_) {
+        thread_pool_ = std::make_unique<thread_pool::ThreadPool>(routing_settings_.thread_count);
+    }
+    if (routing_settings_.route_cache_size > 0) {
+        route_cache_ = std::make_unique<RouteCache>(routing_settings_.route_cache_size);
+    }
     FillVertexes(catalogue);
+    BuildBusLineRouters(catalogue);
+    hub_labels_.reset();
+    if (routing_settings_.router_type == RouterType::IMPLICIT_RIDES) {
+        implicit_router_ = std::make_unique<ImplicitRideRouter>(*bus_lines_
+                                    , static_cast<double>(routing_settings_.bus_wait_time)
+                                    , routing_settings_.bus_velocity);
+        return;
+    }
     FillEdges(catalogue);
-    router_ = std::make_unique<graph::Router<double>>(graph_);
+    graph_.Freeze();
+    search_router_ = std::make_unique<graph::DijkstraRouter<double>>(graph_);
+    alternatives_router_ = std::make_unique<graph::YenRouter<double>>(graph_
+        , [this](const std::vector<graph::EdgeId>& root_edges) {
+            return GetReboardingEdges(root_edges);
+        });
+    BuildHubLabels();
+    switch (routing_settings_.router_type) {
+    case RouterType::ALL_PAIRS:
+        BuildAllPairsRouter();
+        break;
+    case RouterType::DIJKSTRA:
+        router_ = std::make_unique<graph::DijkstraRouter<double>>(graph_);
+        break;
+    case RouterType::A_STAR:
+        ComputeMinTimePerMeter();
+        router_ = std::make_unique<graph::BidirectionalAStarRouter<double>>(graph_
+            , [this](graph::VertexId from, graph::VertexId to) {
+                return GetTimeLowerBound(from, to);
+            });
+        break;
+    case RouterType::CONTRACTION_HIERARCHY:
+        router_ = std::make_unique<graph::ContractionHierarchyRouter<double>>(graph_);
+        break;
+    case RouterType::STOP_TABLE:
+        router_ = BuildStopTableRouter();
+        break;
+    case RouterType::IMPLICIT_RIDES:
+        break;
+    }
 }
 
-const std::optional<std::vector<graph::Edge<double>>> TransportRouter::FindRoute (
-                                                    const std::string_view stop_from
-                                                    , const std::string_view stop_to) const {
-const auto route = router_->BuildRoute(stop_to_vertex_ids_.at(stop_from)
-                                        , stop_to_vertex_ids_.at(stop_to));
+std::optional<RouteView> TransportRouter::FindRoute(const std::string_view stop_from
+                                                   , const std::string_view stop_to
+                                                   , graph::SearchStats* stats) const {
+    const graph::VertexId vertex_from = stop_to_vertex_ids_.at(stop_from);
+    const graph::VertexId vertex_to = stop_to_vertex_ids_.at(stop_to);
+    if (!route_cache_) {
+        return BuildRouteView(vertex_from, vertex_to, stats);
+    }
+    if (auto route = route_cache_->Get({vertex_from, vertex_to})) {
+        if (stats) {
+            *stats = graph::SearchStats{};
+        }
+        return std::move(*route);
+    }
+    auto route = BuildRouteView(vertex_from, vertex_to, stats);
+    route_cache_->Put({vertex_from, vertex_to}, route);
+    return route;
+}
+
+std::optional<double> TransportRouter::FindRouteTime(const std::string_view stop_from
+                                                     , const std::string_view stop_to) const {
+    if (hub_labels_) {
+        return hub_labels_->ComputeWeight(stop_to_vertex_ids_.at(stop_from)
+                                          , stop_to_vertex_ids_.at(stop_to));
+    }
+    const auto route = FindRoute(stop_from, stop_to);
     if (!route) {
         return std::nullopt;
     }
+    return route->GetTotalTime();
+}
+
+std::optional<std::vector<graph::Edge<double>>> TransportRouter::FindRouteAt(
+                                            const std::string_view stop_from
+                                            , const std::string_view stop_to
+                                            , double departure_time) const {
+    return timetable_router_->FindRoute(stop_to_vertex_ids_.at(stop_from)
+                                        , stop_to_vertex_ids_.at(stop_to)
+                                        , departure_time);
+}
+
+std::vector<std::vector<std::optional<double>>> TransportRouter::ComputeTimeMatrix(
+                                            const std::vector<std::string_view>& stops_from
+                                            , const std::vector<std::string_view>& stops_to) const {
+    std::vector<graph::VertexId> vertices_to;
+    vertices_to.reserve(stops_to.size());
+    for (const auto stop_to : stops_to) {
+        vertices_to.push_back(stop_to_vertex_ids_.at(stop_to));
+    }
+    std::vector<graph::VertexId> vertices_from;
+    vertices_from.reserve(stops_from.size());
+    for (const auto stop_from : stops_from) {
+        vertices_from.push_back(stop_to_vertex_ids_.at(stop_from));
+    }
+
+    std::vector<std::vector<std::optional<double>>> result(vertices_from.size());
+    // The precomputed tables answer one pair at a time, so every router type
+    // shares the one-to-many search over the graph; hub labels need no search.
+    thread_pool_->ParallelFor(vertices_from.size(), [&](size_t row) {
+        if (hub_labels_) {
+            result[row].reserve(vertices_to.size());
+            for (const graph::VertexId vertex_to : vertices_to) {
+                result[row].push_back(hub_labels_->ComputeWeight(vertices_from[row], vertex_to));
+            }
+            return;
+        }
+        result[row] = implicit_router_ ? implicit_router_->FindTimes(vertices_from[row], vertices_to)
+                                       : search_router_->BuildWeights(vertices_from[row], vertices_to);
+    });
+    return result;
+}
+
+void TransportRouter::Update(const transport_catalogue::TransportCatalogue& catalogue) {
+    const bool has_router = std::visit([](const auto& router) {
+        return router != nullptr;
+    }, router_);
+    if (routing_settings_.router_type != RouterType::ALL_PAIRS
+        || !has_router
+        || catalogue.GetAllStops().size() != stop_to_vertex_ids_.size()) {
+        BuildGraph(catalogue);
+        return;
+    }
+
+    // Stops are never removed, so the same count means the same stops and vertex ids.
+    const graph::DirectedWeightedGraph<double> old_graph = std::move(graph_);
+    FillVertexes(catalogue);
+    BuildBusLineRouters(catalogue);
+    FillEdges(catalogue);
+    graph_.Freeze();
+    switch (routing_settings_.weight_type) {
+    case WeightType::DOUBLE:
+        UpdateAllPairsRouter(old_graph);
+        break;
+    case WeightType::FLOAT: {
+        const graph::DirectedWeightedGraph<float> old_float_graph = std::move(float_graph_);
+        float_graph_ = ConvertGraph<float>(graph_);
+        UpdateAllPairsRouter(old_float_graph);
+        break;
+    }
+    case WeightType::FIXED_POINT: {
+        const graph::DirectedWeightedGraph<uint32_t> old_fixed_point_graph = std::move(fixed_point_graph_);
+        fixed_point_graph_ = ConvertGraph<uint32_t>(graph_);
+        UpdateAllPairsRouter(old_fixed_point_graph);
+        break;
+    }
+    }
+    BuildHubLabels();
+    if (route_cache_) {
+        route_cache_ = std::make_unique<RouteCache>(routing_settings_.route_cache_size);
+    }
+}
 
-    std::optional<std::vector<graph::Edge<double>>> result
-                                            = std::vector<graph::Edge<double>>{};
-    result->reserve(route.value().edges.size());
+std::vector<std::vector<graph::Edge<double>>> TransportRouter::FindAlternativeRoutes(
+                                            const std::string_view stop_from
+                                            , const std::string_view stop_to
+                                            , size_t route_count) const {
+    const graph::VertexId vertex_from = stop_to_vertex_ids_.at(stop_from);
+    const graph::VertexId vertex_to = stop_to_vertex_ids_.at(stop_to);
+    std::vector<std::vector<graph::Edge<double>>> result;
+    if (implicit_router_) {
+        if (auto route = implicit_router_->FindRoute(vertex_from, vertex_to); route && route_count > 0) {
+            result.push_back(std::move(*route));
+        }
+        return result;
+    }
+    // Routes that leave a bus only to board it again, or ride the same buses as
+    // a route counted before, give the rider nothing new.
+    std::vector<std::vector<uint32_t>> bus_sequences;
+    const auto is_new_bus_sequence = [&](const std::vector<graph::EdgeId>& edge_ids) {
+        std::vector<uint32_t> buses;
+        for (const graph::EdgeId edge_id : edge_ids) {
+            const auto& edge = graph_.GetEdge(edge_id);
+            if (edge.span_count == 0) {
+                continue;
+            }
+            if (!buses.empty() && buses.back() == edge.name_id) {
+                return false;
+            }
+            buses.push_back(edge.name_id);
+        }
+        if (std::find(bus_sequences.begin(), bus_sequences.end(), buses) != bus_sequences.end()) {
+            return false;
+        }
+        bus_sequences.push_back(std::move(buses));
+        return true;
+    };
+    for (const auto& route : alternatives_router_->BuildRoutes(vertex_from, vertex_to, route_count
+                                                               , is_new_bus_sequence)) {
+        auto& edges = result.emplace_back();
+        edges.reserve(route.edges.size());
+        for (const graph::EdgeId edge_id : route.edges) {
+            edges.push_back(graph_.GetEdge(edge_id));
+        }
+    }
+    return result;
+}
 
-    for (const auto& item_edge : route.value().edges) {
-        const graph::Edge<double> edge = graph_.GetEdge(item_edge);
-        result->push_back(edge);
+std::vector<graph::EdgeId> TransportRouter::GetReboardingEdges(
+                                            const std::vector<graph::EdgeId>& root_edges) const {
+    std::vector<graph::EdgeId> result;
+    // The root ends on a ride or on the wait after it.
+    size_t ride_index = root_edges.size();
+    while (ride_index > 0 && root_edges.size() - ride_index < 2) {
+        if (graph_.GetEdge(root_edges[--ride_index]).span_count > 0) {
+            const auto& ride = graph_.GetEdge(root_edges[ride_index]);
+            // A ride ends at a wait vertex, and the board vertex of the same stop follows it.
+            for (const graph::EdgeId edge_id : graph_.GetIncidentEdges(ride.to + 1)) {
+                const auto& edge = graph_.GetEdge(edge_id);
+                if (edge.span_count > 0 && edge.name_id == ride.name_id) {
+                    result.push_back(edge_id);
+                }
+            }
+            break;
+        }
     }
+    return result;
+}
+
+std::vector<std::vector<graph::Edge<double>>> TransportRouter::FindParetoRoutes(
+                                            const std::string_view stop_from
+                                            , const std::string_view stop_to
+                                            , std::optional<size_t> max_transfers) const {
+    return raptor_router_->FindParetoRoutes(stop_to_vertex_ids_.at(stop_from)
+                                            , stop_to_vertex_ids_.at(stop_to)
+                                            , max_transfers ? *max_transfers + 1 : RaptorRouter::NO_RIDE_LIMIT);
+}
+
+std::vector<std::pair<std::string_view, double>> TransportRouter::FindReachableStops(
+                                            const std::string_view stop_from
+                                            , double max_time) const {
+    const graph::VertexId vertex_from = stop_to_vertex_ids_.at(stop_from);
+    const auto reachable_vertices = implicit_router_
+        ? implicit_router_->FindReachable(vertex_from, max_time)
+        : search_router_->BuildReachable(vertex_from, max_time);
 
+    // A stop is reached once its wait vertex is; boarding vertices come after it.
+    std::vector<std::pair<std::string_view, double>> result;
+    for (const auto& [vertex, time] : reachable_vertices) {
+        if (vertex % 2 == 0) {
+            result.push_back({vertex_stop_names_[vertex], time});
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.second, lhs.first) < std::tie(rhs.second, rhs.first);
+    });
     return result;
 }
+
+lru_cache::CacheStats TransportRouter::GetRouteCacheStats() const {
+    return route_cache_ ? route_cache_->GetStats() : lru_cache::CacheStats{};
+}
+
+std::optional<RouteView> TransportRouter::BuildRouteView(graph::VertexId vertex_from
+                                                        , graph::VertexId vertex_to
+                                                        , graph::SearchStats* stats) const {
+    if (implicit_router_) {
+        auto edges = implicit_router_->FindRoute(vertex_from, vertex_to, stats);
+        if (!edges) {
+            return std::nullopt;
+        }
+        double total_time = 0.0;
+        for (const auto& edge : *edges) {
+            total_time += edge.weight;
+        }
+        return RouteView(total_time
+                         , std::make_shared<const std::vector<graph::Edge<double>>>(std::move(*edges)));
+    }
+    return std::visit([this, vertex_from, vertex_to, stats](const auto& router) -> std::optional<RouteView> {
+        auto route = router->BuildRoute(vertex_from, vertex_to, stats);
+        if (!route) {
+            return std::nullopt;
+        }
+        // Tables of float or fixed-point weights only pick the route; its time
+        // is summed from graph_, so the answer matches a double table.
+        double total_time = 0.0;
+        if constexpr (std::is_same_v<decltype(route->weight), double>) {
+            total_time = route->weight;
+        } else {
+            for (const graph::EdgeId edge_id : route->edges) {
+                total_time += graph_.GetEdge(edge_id).weight;
+            }
+        }
+        return RouteView(graph_
+                         , total_time
+                         , std::make_shared<const std::vector<graph::EdgeId>>(std::move(route->edges)));
+    }, router_);
+}
 } // namespace transport_router
\ No newline at end of file
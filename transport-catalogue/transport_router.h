@@ -1,16 +1,138 @@
 #pragma once
 
+#include "astar_router.h"
+#include "bus_lines.h"
+#include "ch_router.h"
+#include "csa_router.h"
+#include "dijkstra_router.h"
+#include "hub_label_index.h"
+#include "implicit_ride_router.h"
+#include "lru_cache.h"
+#include "raptor_router.h"
+#include "reduced_router.h"
 #include "router.h"
+#include "thread_pool.h"
 #include "transport_catalogue.h"
+#include "yen_router.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
+#include <string>
+#include <utility>
 #include <unordered_map>
+#include <variant>
 
 namespace transport_router {
 
+enum class RouterType {
+    ALL_PAIRS,
+    DIJKSTRA,
+    A_STAR,
+    CONTRACTION_HIERARCHY,
+    STOP_TABLE,
+    IMPLICIT_RIDES,
+};
+
+// Weight type of the all_pairs table. FLOAT and FIXED_POINT halve its memory
+// and fill twice as many lanes of the min-plus kernel; route items keep their
+// double times either way.
+enum class WeightType {
+    DOUBLE,
+    FLOAT,
+    // Whole thousandths of a minute in 32 bits.
+    FIXED_POINT,
+};
+
 struct RoutingSettings {
     int bus_wait_time = 0;
     double bus_velocity = 0;
+    RouterType router_type = RouterType::ALL_PAIRS;
+    // Used by the all_pairs router only.
+    WeightType weight_type = WeightType::DOUBLE;
+    size_t thread_count = 1;
+    // When set, the all-pairs table is loaded from this file if it matches the
+    // current graph and is rebuilt and saved there otherwise.
+    std::string cache_file;
+    // Number of finished routes kept in memory for repeated requests, 0 disables the cache.
+    size_t route_cache_size = 0;
+    // Builds hub labels so travel times are answered without a search. Not
+    // available for implicit_rides, which has no ride edges to label.
+    bool hub_labels = false;
+    // When set, the hub labels are loaded from this file if they match the
+    // current graph and are rebuilt and saved there otherwise.
+    std::string hub_label_file;
+};
+
+// A found route read in place: its total time and its edges, kept as ids into
+// the frozen graph or, for routes the graph does not hold (implicit_rides), as
+// the edges themselves. Copies share the storage, so a view costs one
+// allocation when the route is found and none when it comes from the route
+// cache. Edges from the graph stay valid until the router is updated.
+class RouteView {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = graph::Edge<double>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const graph::Edge<double>*;
+        using reference = const graph::Edge<double>&;
+
+        Iterator(const RouteView& route, size_t index)
+            : route_(&route)
+            , index_(index) {
+        }
+        reference operator*() const {
+            return route_->GetEdge(index_);
+        }
+        pointer operator->() const {
+            return &route_->GetEdge(index_);
+        }
+        Iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++index_;
+            return previous;
+        }
+        bool operator==(const Iterator& other) const {
+            return route_ == other.route_ && index_ == other.index_;
+        }
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const RouteView* route_;
+        size_t index_;
+    };
+
+    RouteView(const graph::DirectedWeightedGraph<double>& graph
+              , double total_time
+              , std::shared_ptr<const std::vector<graph::EdgeId>> edge_ids);
+    RouteView(double total_time
+              , std::shared_ptr<const std::vector<graph::Edge<double>>> edges);
+
+    double GetTotalTime() const;
+    size_t GetEdgeCount() const;
+    const graph::Edge<double>& GetEdge(size_t index) const;
+
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    const graph::DirectedWeightedGraph<double>* graph_ = nullptr;
+    double total_time_ = 0.0;
+    std::shared_ptr<const std::vector<graph::EdgeId>> edge_ids_;
+    std::shared_ptr<const std::vector<graph::Edge<double>>> edges_;
+};
+
+struct VertexPairHasher {
+    size_t operator() (const std::pair<graph::VertexId, graph::VertexId>& vertices) const;
 };
 
 class TransportRouter {
@@ -22,18 +144,134 @@ public:
         BuildGraph(catalogue);
     }
 
-    const std::optional<std::vector<graph::Edge<double>>> FindRoute (
+    // Search-based routers report the work done for the query in stats.
+    std::optional<RouteView> FindRoute(const std::string_view stop_from
+                                       , const std::string_view stop_to
+                                       , graph::SearchStats* stats = nullptr) const;
+
+    // Total time of the fastest route without its items, from the hub labels
+    // when they are built and from FindRoute otherwise.
+    std::optional<double> FindRouteTime(const std::string_view stop_from
+                                        , const std::string_view stop_to) const;
+
+    // The route arriving first when leaving stop_from at departure_time, in
+    // minutes after midnight, by buses that have timetables. Waits last until
+    // the boarded trip departs, so the total time counts from departure_time.
+    std::optional<std::vector<graph::Edge<double>>> FindRouteAt(
+                                                const std::string_view stop_from
+                                                , const std::string_view stop_to
+                                                , double departure_time) const;
+
+    // Travel times from every stop in stops_from (rows) to every stop in stops_to
+    // (columns), nullopt where there is no route. Intersects hub labels when they
+    // are built and runs one search per source otherwise, spread over
+    // routing_settings.thread_count threads. Concurrent calls take turns on them.
+    std::vector<std::vector<std::optional<double>>> ComputeTimeMatrix(
+                                                const std::vector<std::string_view>& stops_from
+                                                , const std::vector<std::string_view>& stops_to) const;
+
+    // Up to route_count loopless routes in order of total time, each on its own
+    // sequence of buses and never leaving a bus to board it again, found with
+    // Yen's algorithm over the graph. implicit_rides has no ride edges to branch
+    // on and returns the fastest route alone.
+    std::vector<std::vector<graph::Edge<double>>> FindAlternativeRoutes(
                                                 const std::string_view stop_from
-                                                , const std::string_view stop_to) const;
+                                                , const std::string_view stop_to
+                                                , size_t route_count) const;
+
+    // Routes that are each faster than all routes with fewer transfers, fewest
+    // transfers first, with at most max_transfers transfers when it is given.
+    std::vector<std::vector<graph::Edge<double>>> FindParetoRoutes(
+                                                const std::string_view stop_from
+                                                , const std::string_view stop_to
+                                                , std::optional<size_t> max_transfers = std::nullopt) const;
+
+    // Stops reachable from stop_from within max_time minutes with their travel
+    // times, in order of time. Served by a single search bounded by max_time.
+    std::vector<std::pair<std::string_view, double>> FindReachableStops(
+                                                const std::string_view stop_from
+                                                , double max_time) const;
+
+    lru_cache::CacheStats GetRouteCacheStats() const;
+
+    // Brings the router in line with the catalogue after buses were added,
+    // removed or changed or road distances were set there. With the same stops
+    // the all-pairs table is repaired in place and saved to cache_file; other
+    // router types and changed stops mean a full rebuild. Must not run
+    // concurrently with queries.
+    void Update(const transport_catalogue::TransportCatalogue& catalogue);
 
 private:
+    using RouteCache = lru_cache::ShardedLruCache<std::pair<graph::VertexId, graph::VertexId>
+                                                  , std::optional<RouteView>
+                                                  , VertexPairHasher>;
+
     RoutingSettings routing_settings_;
     graph::DirectedWeightedGraph<double> graph_;
     std::unordered_map<std::string_view, graph::VertexId> stop_to_vertex_ids_;
-    std::unique_ptr<graph::Router<double>> router_;
+    // Coordinates of the stop each vertex belongs to and the least travel time
+    // per meter of geographic distance over all edges, for A* lower bounds.
+    std::vector<geo::Coordinates> vertex_coordinates_;
+    // Name of the stop each vertex belongs to.
+    std::vector<std::string_view> vertex_stop_names_;
+    double min_time_per_meter_ = 0.0;
+    // graph_ with the same edge ids and weights converted for the all_pairs
+    // table when routing_settings.weight_type is not DOUBLE, empty otherwise.
+    graph::DirectedWeightedGraph<float> float_graph_;
+    graph::DirectedWeightedGraph<uint32_t> fixed_point_graph_;
+    std::variant<std::unique_ptr<graph::Router<double>>
+                , std::unique_ptr<graph::Router<float>>
+                , std::unique_ptr<graph::Router<uint32_t>>
+                , std::unique_ptr<graph::DijkstraRouter<double>>
+                , std::unique_ptr<graph::BidirectionalAStarRouter<double>>
+                , std::unique_ptr<graph::ContractionHierarchyRouter<double>>
+                , std::unique_ptr<graph::ReducedRouter<double>>> router_;
+    // One-to-many searches over graph_ for time matrices and reachable stops,
+    // whatever router_ answers single routes with.
+    std::unique_ptr<graph::DijkstraRouter<double>> search_router_;
+    std::unique_ptr<graph::YenRouter<double>> alternatives_router_;
+    // Travel times between wait vertices; null unless routing_settings.hub_labels is set.
+    std::unique_ptr<graph::HubLabelIndex<double>> hub_labels_;
+    // Stops and bus routes for the routers below, which keep references to it.
+    std::unique_ptr<BusLines> bus_lines_;
+    // Replaces graph_ edges and router_ when rides are derived on the fly.
+    std::unique_ptr<ImplicitRideRouter> implicit_router_;
+    // Answers transfer-aware queries for every router type.
+    std::unique_ptr<RaptorRouter> raptor_router_;
+    // Answers departure time queries over bus timetables for every router type.
+    std::unique_ptr<ConnectionScanRouter> timetable_router_;
+    // Routes found so far, keyed by the wait vertices of both stops; null when disabled.
+    std::unique_ptr<RouteCache> route_cache_;
+    // routing_settings.thread_count threads for building edges, route tables
+    // and time matrices, started with the first BuildGraph and kept across updates.
+    std::unique_ptr<thread_pool::ThreadPool> thread_pool_;
 
     void FillVertexes(const transport_catalogue::TransportCatalogue& catalogue);
+    // Number of ride edges FillBusEdges writes for the bus.
+    static size_t CountBusEdges(const transport_catalogue::Bus& bus);
+    void FillBusEdges(const transport_catalogue::TransportCatalogue& catalogue
+                      , const transport_catalogue::Bus& bus
+                      , graph::Edge<double>* edges) const;
     void FillEdges(const transport_catalogue::TransportCatalogue& catalogue);
+    void ComputeMinTimePerMeter();
+    double GetTimeLowerBound(graph::VertexId from, graph::VertexId to) const;
+    template <typename Weight>
+    std::unique_ptr<graph::Router<Weight>> BuildAllPairsRouter(
+                                                const graph::DirectedWeightedGraph<Weight>& graph) const;
+    void BuildAllPairsRouter();
+    // Repairs the all_pairs table built over graph, which has replaced old_graph.
+    template <typename Weight>
+    void UpdateAllPairsRouter(const graph::DirectedWeightedGraph<Weight>& old_graph);
+    std::vector<graph::VertexId> GetWaitVertices() const;
+    // Ride edges of the bus that root_edges last ride, out of the stop where it is left.
+    std::vector<graph::EdgeId> GetReboardingEdges(const std::vector<graph::EdgeId>& root_edges) const;
+    std::unique_ptr<graph::ReducedRouter<double>> BuildStopTableRouter() const;
+    void BuildHubLabels();
+    // Builds bus_lines_ and the routers that scan them for every router type.
+    void BuildBusLineRouters(const transport_catalogue::TransportCatalogue& catalogue);
     void BuildGraph(const transport_catalogue::TransportCatalogue& catalogue);
+    std::optional<RouteView> BuildRouteView(graph::VertexId vertex_from
+                                            , graph::VertexId vertex_to
+                                            , graph::SearchStats* stats) const;
 };
 } // namespace transport_router
\ No newline at end of file
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "graph.h"
+#include "router.h"
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// Yen's algorithm for the k shortest loopless routes. Each next route branches
+// off a previous one at some vertex: the prefix up to it is kept and the rest
+// is searched again with the edges already taken from that prefix blocked, so
+// every route costs one bounded Dijkstra search per edge of the route before it.
+template <typename Weight>
+class YenRouter {
+private:
+    using Graph = DirectedWeightedGraph<Weight>;
+
+public:
+    using RouteInfo = graph::RouteInfo<Weight>;
+
+    // Tells for each loopless route found, in order of weight, whether it is
+    // one of the routes to return. Rejected routes are still branched from.
+    using RouteFilter = std::function<bool(const std::vector<EdgeId>& edges)>;
+    // Edges a route must not take right after root_edges, for rules between
+    // consecutive edges that the graph itself does not express.
+    using ContinuationFilter = std::function<std::vector<EdgeId>(const std::vector<EdgeId>& root_edges)>;
+
+    // Routes explored per route asked for, counted or not. When few routes
+    // pass is_counted the loopless routes left to branch from can be
+    // exponentially many, so the search gives up after this many.
+    static constexpr size_t EXPLORED_ROUTES_PER_ROUTE = 10;
+
+    explicit YenRouter(const Graph& graph, ContinuationFilter blocked_continuations = {});
+
+    // Up to route_count distinct loopless routes in order of weight, the best
+    // first, counting only the routes is_counted accepts when it is given.
+    // Returns the counted routes found so far once route_count *
+    // EXPLORED_ROUTES_PER_ROUTE routes have been explored.
+    std::vector<RouteInfo> BuildRoutes(VertexId from, VertexId to, size_t route_count
+                                       , const RouteFilter& is_counted = {}) const;
+
+private:
+    using QueueItem = std::pair<Weight, VertexId>;
+    using Queue = std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>>;
+    // Weight of a candidate route and its index in the order candidates were found.
+    using CandidateItem = std::pair<Weight, size_t>;
+    using CandidateQueue = std::priority_queue<CandidateItem, std::vector<CandidateItem>
+                                               , std::greater<CandidateItem>>;
+
+    struct EdgesHasher {
+        size_t operator()(const std::vector<EdgeId>& edges) const {
+            size_t hash = edges.size();
+            for (const EdgeId edge_id : edges) {
+                hash = hash * 37 + std::hash<EdgeId>{}(edge_id);
+            }
+            return hash;
+        }
+    };
+
+    static constexpr Weight ZERO_WEIGHT{};
+
+    // Dijkstra search that never enters blocked_vertices or uses blocked_edges.
+    // Both lists are short, so they are scanned rather than indexed.
+    std::optional<std::vector<EdgeId>> BuildSpurRoute(VertexId from, VertexId to,
+                                                      const std::vector<VertexId>& blocked_vertices,
+                                                      const std::vector<EdgeId>& blocked_edges) const;
+    Weight GetRouteWeight(const std::vector<EdgeId>& edges) const;
+
+    const Graph& graph_;
+    ContinuationFilter blocked_continuations_;
+};
+
+template <typename Weight>
+YenRouter<Weight>::YenRouter(const Graph& graph, ContinuationFilter blocked_continuations)
+    : graph_(graph)
+    , blocked_continuations_(std::move(blocked_continuations))
+{
+    CheckNonNegativeWeights(graph);
+}
+
+template <typename Weight>
+Weight YenRouter<Weight>::GetRouteWeight(const std::vector<EdgeId>& edges) const {
+    Weight weight = ZERO_WEIGHT;
+    for (const EdgeId edge_id : edges) {
+        weight += graph_.GetEdge(edge_id).weight;
+    }
+    return weight;
+}
+
+template <typename Weight>
+std::optional<std::vector<EdgeId>> YenRouter<Weight>::BuildSpurRoute(
+                                                    VertexId from,
+                                                    VertexId to,
+                                                    const std::vector<VertexId>& blocked_vertices,
+                                                    const std::vector<EdgeId>& blocked_edges) const {
+    const auto is_blocked = [](const auto& blocked, auto id) {
+        return std::find(blocked.begin(), blocked.end(), id) != blocked.end();
+    };
+    // Spur searches usually settle a small part of the graph, so the labels
+    // are kept sparse instead of sized to the vertex count.
+    std::unordered_map<VertexId, std::pair<Weight, std::optional<EdgeId>>> labels;
+    Queue queue;
+    labels[from] = {ZERO_WEIGHT, std::nullopt};
+    queue.push({ZERO_WEIGHT, from});
+
+    while (!queue.empty()) {
+        const auto [weight, vertex] = queue.top();
+        queue.pop();
+        if (weight > labels.at(vertex).first) {
+            continue;
+        }
+        if (vertex == to) {
+            std::vector<EdgeId> edges;
+            for (auto edge_id = labels.at(to).second; edge_id;
+                 edge_id = labels.at(graph_.GetEdge(*edge_id).from).second) {
+                edges.push_back(*edge_id);
+            }
+            std::reverse(edges.begin(), edges.end());
+            return edges;
+        }
+        for (const EdgeId edge_id : graph_.GetIncidentEdges(vertex)) {
+            const auto& edge = graph_.GetEdge(edge_id);
+            if (is_blocked(blocked_vertices, edge.to) || is_blocked(blocked_edges, edge_id)) {
+                continue;
+            }
+            const Weight candidate_weight = weight + edge.weight;
+            const auto label = labels.find(edge.to);
+            if (label == labels.end() || candidate_weight < label->second.first) {
+                labels[edge.to] = {candidate_weight, edge_id};
+                queue.push({candidate_weight, edge.to});
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+template <typename Weight>
+std::vector<typename YenRouter<Weight>::RouteInfo> YenRouter<Weight>::BuildRoutes(
+                                                    VertexId from,
+                                                    VertexId to,
+                                                    size_t route_count,
+                                                    const RouteFilter& is_counted) const {
+    if (from >= graph_.GetVertexCount() || to >= graph_.GetVertexCount()) {
+        throw std::out_of_range("Vertex id is out of range");
+    }
+    std::vector<RouteInfo> result;
+    if (route_count == 0) {
+        return result;
+    }
+    auto best_edges = BuildSpurRoute(from, to, {}, {});
+    if (!best_edges) {
+        return result;
+    }
+    // Every route found so far, counted or not, for branching and blocking.
+    std::vector<RouteInfo> routes;
+    const auto add_route = [&](RouteInfo route) {
+        if (!is_counted || is_counted(route.edges)) {
+            result.push_back(route);
+        }
+        routes.push_back(std::move(route));
+    };
+    // Routes and candidates alike, so that no route is queued twice.
+    std::unordered_set<std::vector<EdgeId>, EdgesHasher> seen_routes{*best_edges};
+    add_route({GetRouteWeight(*best_edges), std::move(*best_edges)});
+
+    // Candidates keep their slots once taken, so that ties go to the one found first.
+    std::vector<RouteInfo> candidates;
+    CandidateQueue candidate_queue;
+    const size_t max_route_count = route_count * EXPLORED_ROUTES_PER_ROUTE;
+    while (result.size() < route_count && routes.size() < max_route_count) {
+        const std::vector<EdgeId> last_edges = routes.back().edges;
+        std::vector<VertexId> root_vertices;
+        for (size_t spur_index = 0; spur_index < last_edges.size(); ++spur_index) {
+            const VertexId spur_vertex = graph_.GetEdge(last_edges[spur_index]).from;
+            // Routes sharing the root must leave the spur vertex by another edge.
+            std::vector<EdgeId> blocked_edges;
+            for (const RouteInfo& route : routes) {
+                if (route.edges.size() > spur_index
+                    && std::equal(last_edges.begin(), last_edges.begin() + spur_index, route.edges.begin())) {
+                    blocked_edges.push_back(route.edges[spur_index]);
+                }
+            }
+            if (blocked_continuations_) {
+                const std::vector<EdgeId> root_edges(last_edges.begin(), last_edges.begin() + spur_index);
+                const std::vector<EdgeId> continuations = blocked_continuations_(root_edges);
+                blocked_edges.insert(blocked_edges.end(), continuations.begin(), continuations.end());
+            }
+            root_vertices.push_back(spur_vertex);
+            auto spur_edges = BuildSpurRoute(spur_vertex, to, root_vertices, blocked_edges);
+            if (!spur_edges) {
+                continue;
+            }
+            std::vector<EdgeId> edges(last_edges.begin(), last_edges.begin() + spur_index);
+            edges.insert(edges.end(), spur_edges->begin(), spur_edges->end());
+            if (seen_routes.insert(edges).second) {
+                const Weight weight = GetRouteWeight(edges);
+                candidate_queue.push({weight, candidates.size()});
+                candidates.push_back({weight, std::move(edges)});
+            }
+        }
+        if (candidate_queue.empty()) {
+            break;
+        }
+        add_route(std::move(candidates[candidate_queue.top().second]));
+        candidate_queue.pop();
+    }
+    return result;
+}
+
+}  // namespace graph